@@ -0,0 +1,126 @@
+#include "Benchmarks.h"
+
+#include <socklib/BufferPool.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace socklib;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	constexpr size_t WORKING_SET = 128 * MiB;
+	constexpr size_t QUICK_WORKING_SET = 32 * MiB;
+	constexpr size_t BUFFER_SIZE = 64 * KiB;
+	constexpr size_t COPY_ROUNDS = 8;
+	constexpr size_t SAMPLES = 200000;
+	constexpr size_t QUICK_SAMPLES = 50000;
+	//Dependent reads timed together, a single one is too short for the clock
+	constexpr size_t READS_PER_SAMPLE = 16;
+
+	enum class Source { Heap, Normal, Huge };
+
+	//Copies every buffer into the next one, then chases random cache lines across all of them
+	void Measure(Report& report, const std::vector<BYTE*>& buffers, const char* name, const size_t samples)
+	{
+		const size_t count = buffers.size();
+		for (BYTE* buffer : buffers)
+			memset(buffer, 0xAB, BUFFER_SIZE);//Faults in whatever wasn't prefaulted, outside of the measurements
+
+		Record copy;
+		copy.Benchmark = std::string("arena-copy-") + name;
+		copy.Transport = "mem";
+		copy.MessageSize = BUFFER_SIZE;
+		const Clock::time_point start = Clock::now();
+		for (size_t round = 0; round < COPY_ROUNDS; round++)
+			for (size_t i = 0; i < count; i++)
+				memcpy(buffers[(i + 1) % count], buffers[i], BUFFER_SIZE);
+		copy.Seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		copy.Messages = COPY_ROUNDS * count;
+		report.Add(copy);
+
+		Record random;
+		random.Benchmark = std::string("arena-random-") + name;
+		random.Transport = "mem";
+		random.MessageSize = 64;
+		std::vector<int64_t> nanos;
+		nanos.reserve(samples);
+		uint64_t state = 0x9E3779B97F4A7C15;
+		uint64_t value = 0;
+		const Clock::time_point randomStart = Clock::now();
+		for (size_t i = 0; i < samples; i++)
+		{
+			const Clock::time_point begin = Clock::now();
+			for (size_t read = 0; read < READS_PER_SAMPLE; read++)
+			{
+				//The next address depends on the byte just read, so the reads can't overlap
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				const uint64_t line = (state ^ (value & 1)) % (count * (BUFFER_SIZE / 64));
+				value = buffers[line / (BUFFER_SIZE / 64)][line % (BUFFER_SIZE / 64) * 64];
+			}
+			DoNotOptimize(value);
+			nanos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+		}
+		random.Seconds = std::chrono::duration<double>(Clock::now() - randomStart).count();
+		random.Messages = samples * READS_PER_SAMPLE;
+		random.SetLatencies(nanos);
+		report.Add(random);
+	}
+
+	void Run(Report& report, const Source source, const size_t set, const size_t samples)
+	{
+		const size_t count = set / BUFFER_SIZE;
+		if (source == Source::Heap)
+		{
+			std::vector<std::unique_ptr<BYTE[]>> memory;
+			std::vector<BYTE*> buffers;
+			for (size_t i = 0; i < count; i++)
+			{
+				memory.emplace_back(new BYTE[BUFFER_SIZE]);
+				buffers.push_back(memory.back().get());
+			}
+			Measure(report, buffers, "heap", samples);
+			return;
+		}
+
+		ArenaOptions options;
+		options.HugePages = source == Source::Huge;
+		const Result<ArenaPages> pages = BufferPool::Reserve(BUFFER_SIZE, count, options);
+		if (!pages)
+		{
+			printf("  Failed to reserve an arena: %s\n", pages.error().message().c_str());
+			return;
+		}
+		const char* name = *pages == ArenaPages::Huge ? "hugetlb" : *pages == ArenaPages::Transparent ? "thp" : "normal";
+
+		//A fresh thread has an empty cache, so every buffer comes from the arena that was just reserved
+		std::thread([&report, count, name, samples]()
+		{
+			std::vector<PooledBuffer> pooled;
+			std::vector<BYTE*> buffers;
+			for (size_t i = 0; i < count; i++)
+			{
+				pooled.push_back(BufferPool::Acquire(BUFFER_SIZE));
+				buffers.push_back(pooled.back().Data());
+			}
+			Measure(report, buffers, name, samples);
+		}).join();
+	}
+
+}
+
+void RunArenaBenchmark(Report& report, const BenchOptions& options)
+{
+	const size_t set = options.Quick ? QUICK_WORKING_SET : WORKING_SET;
+	const size_t samples = options.Quick ? QUICK_SAMPLES : SAMPLES;
+	printf("Arena benchmark: %zu MiB of %zu KiB buffers from the heap vs BufferPool arenas, latency per %zu dependent reads\n", set / MiB, BUFFER_SIZE / KiB, READS_PER_SAMPLE);
+	for (const Source source : { Source::Heap, Source::Normal, Source::Huge })
+		Run(report, source, set, samples);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Report.h"
+
+/**
+* @brief Makes the compiler assume the value is used, so the work producing it isn't optimized away
+*/
+template<typename T>
+inline void DoNotOptimize(const T& value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	const volatile T sink = value;
+	(void)sink;
+#endif
+}
+
+/**
+* @brief Compares copy throughput and random access latency of heap buffers against
+*	BufferPool arenas backed by normal and huge pages
+*/
+void RunArenaBenchmark(Report& report, const BenchOptions& options);
+
+/**
+* @brief Compares receiving/sending datagrams one per system call against the batched APIs
+*/
+void RunDatagramBenchmark(Report& report, const BenchOptions& options);
+
+/**
+* @brief Measures round trip latency and throughput of TCP and UDP echoes,
+*	sweeping message sizes and the number of concurrent clients
+*/
+void RunEchoBenchmark(Report& report, const BenchOptions& options);
+
+/**
+* @brief Compares streaming through a splice() based Relay against a user space copying relay
+*/
+void RunRelayBenchmark(Report& report, const BenchOptions& options);
+
+/**
+* @brief Compares sending small messages one per system call against coalescing them with a BufferedWriter
+*/
+void RunWriterBenchmark(Report& report, const BenchOptions& options);
@@ -0,0 +1,116 @@
+#include "Benchmarks.h"
+
+#include <socklib/Socket.h>
+
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <vector>
+
+using namespace socklib;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	constexpr size_t PACKETS = 1000000;
+	constexpr size_t QUICK_PACKETS = 100000;
+	constexpr size_t PACKET_SIZE = 64;
+	constexpr size_t BATCH = 64;
+	constexpr unsigned short PORT = 55705;
+
+	//Rate is measured end to end: from the first send until the last datagram is received
+	struct Measurement {
+		size_t Sent = 0;
+		size_t Received = 0;
+		double Seconds = 0.0;
+	};
+
+	Measurement Run(const bool batched, const size_t packets)
+	{
+		const Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+		receiver.Bind("127.0.0.1", PORT);
+		constexpr int bufferSize = 8 * MiB;//Let the receiver absorb bursts (capped by net.core.rmem_max)
+		setsockopt(receiver.FileNo(), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(int));
+		receiver.SetTimeout(100);//Sender is done once nothing arrives for a while
+
+		auto task = std::async(std::launch::async, [&receiver, batched]()
+		{
+			std::vector<BYTE> buffers(BATCH * PACKET_SIZE);
+			std::vector<Datagram> datagrams(BATCH);
+			for (size_t i = 0; i < BATCH; i++)
+			{
+				datagrams[i].Data = &buffers[i * PACKET_SIZE];
+				datagrams[i].Length = PACKET_SIZE;
+			}
+
+			size_t received = 0;
+			Clock::time_point last;
+			while (true)
+			{
+				IOSize count;
+				if (batched)
+					count = receiver.ReceiveBatch(datagrams);
+				else
+				{
+					SocketAddress address;
+					count = receiver.ReceiveFrom(buffers.data(), address, PACKET_SIZE) == -1 ? -1 : 1;
+				}
+				if (count == -1) break;
+
+				last = Clock::now();
+				received += count;
+			}
+			return std::make_pair(received, last);
+		});
+
+		const Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+		const SocketAddress address = SocketAddress::Parse("127.0.0.1", PORT);
+
+		std::vector<BYTE> payload(BATCH * PACKET_SIZE, 0xAB);
+		std::vector<Datagram> datagrams(BATCH);
+		for (size_t i = 0; i < BATCH; i++)
+		{
+			datagrams[i].Data = &payload[i * PACKET_SIZE];
+			datagrams[i].Length = PACKET_SIZE;
+			datagrams[i].Address = address;
+		}
+
+		Measurement result;
+		const Clock::time_point start = Clock::now();
+		while (result.Sent < packets)
+		{
+			if (batched)
+			{
+				const IOSize count = sender.SendBatch(datagrams);
+				if (count > 0) result.Sent += count;
+			}
+			else if (sender.SendTo(payload.data(), address, PACKET_SIZE) != -1)
+				result.Sent++;
+		}
+
+		const auto [received, last] = task.get();
+		result.Received = received;
+		result.Seconds = std::chrono::duration<double>(last - start).count();
+		return result;
+	}
+
+}
+
+void RunDatagramBenchmark(Report& report, const BenchOptions& options)
+{
+	const size_t packets = options.Quick ? QUICK_PACKETS : PACKETS;
+	printf("Datagram benchmark: %zu packets of %zu bytes over loopback\n", packets, PACKET_SIZE);
+	for (const bool batched : { false, true })
+	{
+		const Measurement result = Run(batched, packets);
+		Record record;
+		record.Benchmark = batched ? "datagram-batched" : "datagram-per-call";
+		record.Transport = "udp";
+		record.MessageSize = PACKET_SIZE;
+		record.Messages = result.Received;
+		record.Seconds = result.Seconds;
+		report.Add(record);
+		if (result.Received < result.Sent)
+			printf("  (%zu of %zu packets were dropped)\n", result.Sent - result.Received, result.Sent);
+	}
+}
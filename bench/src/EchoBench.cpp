@@ -0,0 +1,218 @@
+#include "Benchmarks.h"
+
+#include <socklib/Socket.h>
+#ifndef PLATFORM_WINDOWS
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <latch>
+#include <thread>
+#include <vector>
+
+using namespace socklib;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	constexpr unsigned short TCP_PORT = 55815;
+	constexpr unsigned short UDP_PORT = 55816;//Every concurrent client gets its own server port from here on
+	constexpr size_t MAX_DATAGRAM = 65507;//Largest UDP payload over IPv4
+	constexpr size_t CONCURRENCY[] = { 1, 4, 16 };
+
+	//Per client results, merged once every client is done
+	struct ClientResult {
+		size_t Messages = 0;
+		std::vector<int64_t> Latencies;
+	};
+
+	bool SendAll(const Socket& sock, const BYTE* data, const size_t length)
+	{
+		size_t sent = 0;
+		while (sent < length)
+		{
+			const Result<size_t> bytes = sock.TrySend(data, length - sent, sent);
+			if (!bytes || *bytes == 0) return false;
+			sent += *bytes;
+		}
+		return true;
+	}
+
+	bool ReceiveAll(const Socket& sock, BYTE* data, const size_t length)
+	{
+		size_t received = 0;
+		while (received < length)
+		{
+			const Result<size_t> bytes = sock.TryReceive(data, length - received, received);
+			if (!bytes || *bytes == 0) return false;
+			received += *bytes;
+		}
+		return true;
+	}
+
+	void DisableNagle(const Socket& sock)
+	{
+		constexpr int flag = 1;//Ping-pong over Nagle + delayed ACK would only measure the ACK timer
+		setsockopt(sock.FileNo(), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(int));
+	}
+
+	Record Merge(const char* benchmark, const char* transport, const size_t size, std::vector<ClientResult>& results, const double seconds)
+	{
+		Record record;
+		record.Benchmark = benchmark;
+		record.Transport = transport;
+		record.MessageSize = size;
+		record.Concurrency = results.size();
+		record.Seconds = seconds;
+
+		std::vector<int64_t> latencies;
+		for (ClientResult& result : results)
+		{
+			record.Messages += result.Messages;
+			latencies.insert(latencies.end(), result.Latencies.begin(), result.Latencies.end());
+		}
+		record.SetLatencies(latencies);
+		return record;
+	}
+
+	//Every client sends a message, waits for the echo and records the round trip until the time is up
+	Record RunTcp(const size_t size, const size_t concurrency, const Clock::duration duration)
+	{
+		const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", TCP_PORT });
+		std::vector<Socket> clients;
+		std::vector<std::thread> echoes;
+		for (size_t i = 0; i < concurrency; i++)
+		{
+			clients.push_back(Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", TCP_PORT }));
+			Socket peer = server.Accept().first;
+			DisableNagle(clients.back());
+			DisableNagle(peer);
+			echoes.emplace_back([peer, size]()
+			{
+				std::vector<BYTE> buffer(size);
+				while (ReceiveAll(peer, buffer.data(), size) && SendAll(peer, buffer.data(), size)) {}
+			});
+		}
+
+		std::vector<ClientResult> results(concurrency);
+		std::vector<std::thread> threads;
+		std::latch ready(static_cast<std::ptrdiff_t>(concurrency) + 1);
+		Clock::time_point deadline;
+		for (size_t i = 0; i < concurrency; i++)
+		{
+			threads.emplace_back([&, i]()
+			{
+				std::vector<BYTE> buffer(size, 0xAB);
+				ClientResult& result = results[i];
+				ready.arrive_and_wait();
+				while (Clock::now() < deadline)
+				{
+					const Clock::time_point start = Clock::now();
+					if (!SendAll(clients[i], buffer.data(), size) || !ReceiveAll(clients[i], buffer.data(), size)) break;
+					result.Latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+					result.Messages++;
+				}
+			});
+		}
+
+		const Clock::time_point start = Clock::now();
+		deadline = start + duration;
+		ready.arrive_and_wait();
+		for (std::thread& thread : threads)
+			thread.join();
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		for (const Socket& client : clients)
+			client.Shutdown(SHUT_RDWR);//Echo threads see the end of the stream and return
+		for (std::thread& echo : echoes)
+			echo.join();
+		return Merge("echo", "tcp", size, results, seconds);
+	}
+
+	//Same as RunTcp with datagrams, a lost datagram times out and is not counted
+	Record RunUdp(const size_t size, const size_t concurrency, const Clock::duration duration)
+	{
+		std::atomic<bool> stop = false;
+		std::vector<std::thread> echoes;
+		std::vector<SocketAddress> addresses;
+		for (size_t i = 0; i < concurrency; i++)
+		{
+			const auto port = static_cast<unsigned short>(UDP_PORT + i);
+			addresses.push_back(SocketAddress::Parse("127.0.0.1", port));
+			Socket peer(AddressFamily::IPv4, SocketType::DGRAM);
+			peer.Bind(addresses.back());
+			peer.SetTimeout(50);
+			echoes.emplace_back([peer, size, &stop]()
+			{
+				std::vector<BYTE> buffer(size);
+				SocketAddress from;
+				while (!stop)
+				{
+					const Result<size_t> bytes = peer.TryReceiveFrom(buffer.data(), from, size);
+					if (bytes)
+						(void)peer.TrySendTo(buffer.data(), from, *bytes);
+				}
+			});
+		}
+
+		std::vector<ClientResult> results(concurrency);
+		std::vector<std::thread> threads;
+		std::latch ready(static_cast<std::ptrdiff_t>(concurrency) + 1);
+		Clock::time_point deadline;
+		for (size_t i = 0; i < concurrency; i++)
+		{
+			threads.emplace_back([&, i]()
+			{
+				const Socket client(AddressFamily::IPv4, SocketType::DGRAM);
+				client.SetTimeout(200);
+				std::vector<BYTE> buffer(size, 0xAB);
+				SocketAddress from;
+				ClientResult& result = results[i];
+				ready.arrive_and_wait();
+				while (Clock::now() < deadline)
+				{
+					const Clock::time_point start = Clock::now();
+					if (!client.TrySendTo(buffer.data(), addresses[i], size)) continue;
+					if (!client.TryReceiveFrom(buffer.data(), from, size)) continue;
+					result.Latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+					result.Messages++;
+				}
+			});
+		}
+
+		const Clock::time_point start = Clock::now();
+		deadline = start + duration;
+		ready.arrive_and_wait();
+		for (std::thread& thread : threads)
+			thread.join();
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		stop = true;
+		for (std::thread& echo : echoes)
+			echo.join();
+		return Merge("echo", "udp", size, results, seconds);
+	}
+
+}
+
+void RunEchoBenchmark(Report& report, const BenchOptions& options)
+{
+	printf("Echo benchmark: round trips over loopback, message sizes from 16 B to 1 MiB\n");
+	const Clock::duration duration = options.Quick ? std::chrono::milliseconds(50) : std::chrono::milliseconds(500);
+	const size_t largest = options.Quick ? 64 * KiB : MiB;
+
+	for (size_t size = 16; size <= largest; size *= 4)
+	{
+		for (const size_t concurrency : CONCURRENCY)
+			report.Add(RunTcp(size, concurrency, duration));
+	}
+
+	for (size_t size = 16; size <= std::min(largest, MAX_DATAGRAM); size *= 4)
+	{
+		for (const size_t concurrency : CONCURRENCY)
+			report.Add(RunUdp(size, concurrency, duration));
+	}
+}
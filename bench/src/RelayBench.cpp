@@ -0,0 +1,108 @@
+#include "Benchmarks.h"
+
+#include <socklib/Relay.h>
+
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace socklib;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	constexpr size_t CHUNK = 64 * KiB;
+	constexpr size_t BYTES = 2048 * MiB;
+	constexpr size_t QUICK_BYTES = 256 * MiB;
+	constexpr unsigned short FRONT_PORT = 55835;
+	constexpr unsigned short BACK_PORT = 55836;
+
+	//Classic user space relay for comparison: one thread per direction copying through a buffer
+	void CopyRelay(const Socket& from, const Socket& to)
+	{
+		std::vector<BYTE> buffer(CHUNK);
+		IOSize bytes;
+		while ((bytes = from.Receive(buffer.data(), CHUNK)) > 0)
+		{
+			for (IOSize sent = 0; sent < bytes;)
+			{
+				const IOSize result = to.Send(buffer.data(), bytes - sent, sent);
+				if (result <= 0) return;
+				sent += result;
+			}
+		}
+		to.Shutdown(SHUT_WR);
+	}
+
+	//Streams bytes from a client through the relay to a server, measured until the server has received everything
+	Record Run(const bool splice, const size_t total)
+	{
+		const Socket front = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", FRONT_PORT });
+		const Socket back = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", BACK_PORT });
+		const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", FRONT_PORT });
+		const Socket inbound = front.Accept().first;
+		const Socket outbound = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", BACK_PORT });
+		const Socket server = back.Accept().first;
+
+		std::thread relay([&]()
+		{
+			if (splice)
+			{
+				Poller poller;
+				Relay relay(poller, inbound, outbound, [&poller](Relay&) { poller.Stop(); });
+				poller.Run();
+			}
+			else
+			{
+				std::thread backward([&]() { CopyRelay(outbound, inbound); });
+				CopyRelay(inbound, outbound);
+				backward.join();
+			}
+		});
+
+		auto sink = std::async(std::launch::async, [&server]()
+		{
+			std::vector<BYTE> buffer(CHUNK);
+			size_t received = 0;
+			IOSize bytes;
+			while ((bytes = server.Receive(buffer.data(), CHUNK)) > 0)
+				received += bytes;
+			server.Shutdown(SHUT_WR);
+			return std::make_pair(received, Clock::now());
+		});
+
+		const std::vector<BYTE> payload(CHUNK, 0xAB);
+		const Clock::time_point start = Clock::now();
+		for (size_t sent = 0; sent < total;)
+		{
+			const IOSize bytes = client.Send(payload.data(), CHUNK);
+			if (bytes <= 0) break;
+			sent += bytes;
+		}
+		client.Shutdown(SHUT_WR);
+
+		const auto [received, end] = sink.get();
+		char byte;
+		client.Receive(&byte, 1);//Wait for the shutdown of the server to make it through, so the relay is done
+		relay.join();
+
+		Record record;
+		record.Benchmark = splice ? "relay-splice" : "relay-copy";
+		record.Transport = "tcp";
+		record.MessageSize = CHUNK;
+		record.Messages = received / CHUNK;
+		record.Seconds = std::chrono::duration<double>(end - start).count();
+		return record;
+	}
+
+}
+
+void RunRelayBenchmark(Report& report, const BenchOptions& options)
+{
+	const size_t total = options.Quick ? QUICK_BYTES : BYTES;
+	printf("Relay benchmark: %zu MiB streamed through a relay over loopback\n", total / MiB);
+	for (const bool splice : { false, true })
+		report.Add(Run(splice, total));
+}
@@ -0,0 +1,54 @@
+#include "Report.h"
+
+#include <algorithm>
+#include <cstdio>
+
+void Record::SetLatencies(std::vector<int64_t>& nanos)
+{
+	HasLatency = !nanos.empty();
+	if (!HasLatency) return;
+
+	auto percentile = [&nanos](const double p)
+	{
+		const size_t index = std::min(nanos.size() - 1, static_cast<size_t>(p * static_cast<double>(nanos.size())));
+		std::nth_element(nanos.begin(), nanos.begin() + static_cast<std::ptrdiff_t>(index), nanos.end());
+		return static_cast<double>(nanos[index]) / 1e3;
+	};
+	P50 = percentile(0.5);
+	P99 = percentile(0.99);
+	P999 = percentile(0.999);
+}
+
+void Report::Add(const Record& record)
+{
+	if (mRecords.empty())
+		printf("  %-20s %-5s %9s %5s %10s %12s %10s %10s %10s\n", "benchmark", "proto", "size", "conc", "MB/s", "msgs/s", "p50 us", "p99 us", "p999 us");
+
+	printf("  %-20s %-5s %9zu %5zu %10.1f %12.0f", record.Benchmark.c_str(), record.Transport.c_str(), record.MessageSize, record.Concurrency, record.MegabytesPerSecond(), record.MessagesPerSecond());
+	if (record.HasLatency)
+		printf(" %10.1f %10.1f %10.1f\n", record.P50, record.P99, record.P999);
+	else
+		printf(" %10s %10s %10s\n", "-", "-", "-");
+	fflush(stdout);
+
+	mRecords.push_back(record);
+}
+
+bool Report::WriteJson(const char* path) const
+{
+	FILE* file = fopen(path, "w");
+	if (file == nullptr) return false;
+
+	fprintf(file, "{\n  \"library\": \"socklib\",\n  \"results\": [");
+	for (size_t i = 0; i < mRecords.size(); i++)
+	{
+		const Record& record = mRecords[i];
+		fprintf(file, "%s\n    {\"benchmark\": \"%s\", \"transport\": \"%s\", \"message_size\": %zu, \"concurrency\": %zu, ", i == 0 ? "" : ",", record.Benchmark.c_str(), record.Transport.c_str(), record.MessageSize, record.Concurrency);
+		fprintf(file, "\"messages\": %zu, \"seconds\": %.6f, \"mb_per_s\": %.3f, \"msgs_per_s\": %.1f", record.Messages, record.Seconds, record.MegabytesPerSecond(), record.MessagesPerSecond());
+		if (record.HasLatency)
+			fprintf(file, ", \"latency_us\": {\"p50\": %.3f, \"p99\": %.3f, \"p999\": %.3f}", record.P50, record.P99, record.P999);
+		fprintf(file, "}");
+	}
+	fprintf(file, "\n  ]\n}\n");
+	return fclose(file) == 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* @brief Settings shared by every benchmark
+*/
+struct BenchOptions {
+	/**
+	* @brief Shorter runs and a smaller sweep, for smoke testing
+	*/
+	bool Quick = false;
+};
+
+/**
+* @brief One measured configuration of a benchmark
+*/
+struct Record {
+	std::string Benchmark;
+	std::string Transport;
+	size_t MessageSize = 0;
+	size_t Concurrency = 1;
+	size_t Messages = 0;
+	double Seconds = 0.0;
+	/**
+	* @brief Latency percentiles in microseconds, only meaningful if HasLatency is true
+	*/
+	double P50 = 0.0, P99 = 0.0, P999 = 0.0;
+	bool HasLatency = false;
+
+	/**
+	* @brief Fills the latency percentiles from the measured samples
+	* @param nanos Latency of every message in nanoseconds, it gets reordered
+	*/
+	void SetLatencies(std::vector<int64_t>& nanos);
+
+	[[nodiscard]] double MessagesPerSecond() const noexcept { return Seconds > 0.0 ? static_cast<double>(Messages) / Seconds : 0.0; }
+	[[nodiscard]] double MegabytesPerSecond() const noexcept { return MessagesPerSecond() * static_cast<double>(MessageSize) / 1e6; }
+};
+
+/**
+* @brief Collects the records of a run, prints them as they come and exports them as JSON
+*/
+class Report {
+public:
+
+	/**
+	* @brief Adds a record and prints it as a row of the human readable table
+	*/
+	void Add(const Record& record);
+
+	/**
+	* @brief Writes every record to a JSON file so runs can be compared release to release
+	* @param path Path of the file, it is overwritten
+	* @return True if the file was written
+	*/
+	bool WriteJson(const char* path) const;
+
+private:
+
+	std::vector<Record> mRecords;
+
+};
@@ -0,0 +1,75 @@
+#include "Benchmarks.h"
+
+#include <socklib/BufferedWriter.h>
+
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <vector>
+
+using namespace socklib;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	constexpr size_t MESSAGES = 2000000;
+	constexpr size_t QUICK_MESSAGES = 200000;
+	constexpr size_t MESSAGE_SIZE = 64;
+	constexpr unsigned short PORT = 55837;
+
+	enum class Mode { Raw, Buffered, Corked };
+
+	//Streams small messages to a sink, measured until the sink has received everything
+	Record Run(const Mode mode, const size_t messages)
+	{
+		const Socket listener = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", PORT });
+		const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", PORT });
+		const Socket server = listener.Accept().first;
+
+		auto sink = std::async(std::launch::async, [&server]()
+		{
+			std::vector<BYTE> buffer(64 * KiB);
+			size_t received = 0;
+			IOSize bytes;
+			while ((bytes = server.Receive(buffer.data(), buffer.size())) > 0)
+				received += bytes;
+			return std::make_pair(received, Clock::now());
+		});
+
+		const std::vector<BYTE> message(MESSAGE_SIZE, 0xAB);
+		const Clock::time_point start = Clock::now();
+		if (mode == Mode::Raw)
+		{
+			for (size_t i = 0; i < messages; i++)
+				if (client.Send(message.data(), MESSAGE_SIZE) != MESSAGE_SIZE) break;
+		}
+		else
+		{
+			BufferedWriterOptions options;
+			options.Cork = mode == Mode::Corked;
+			BufferedWriter writer(client, options);
+			for (size_t i = 0; i < messages; i++)
+				if (!writer.Write(message.data(), MESSAGE_SIZE)) break;
+			(void)writer.Flush();
+		}
+		client.Shutdown(SHUT_WR);
+
+		const auto [received, end] = sink.get();
+		Record record;
+		record.Benchmark = mode == Mode::Raw ? "writer-raw" : mode == Mode::Buffered ? "writer-buffered" : "writer-corked";
+		record.Transport = "tcp";
+		record.MessageSize = MESSAGE_SIZE;
+		record.Messages = received / MESSAGE_SIZE;
+		record.Seconds = std::chrono::duration<double>(end - start).count();
+		return record;
+	}
+
+}
+
+void RunWriterBenchmark(Report& report, const BenchOptions& options)
+{
+	const size_t messages = options.Quick ? QUICK_MESSAGES : MESSAGES;
+	printf("Writer benchmark: %zu messages of %zu bytes, one Send each vs a BufferedWriter\n", messages, MESSAGE_SIZE);
+	for (const Mode mode : { Mode::Raw, Mode::Buffered, Mode::Corked })
+		report.Add(Run(mode, messages));
+}
@@ -0,0 +1,39 @@
+#define SOCK_MAIN
+#include <socklib/Platform.h>
+
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main(const int argc, char** argv)
+{
+	BenchOptions options;
+	const char* json = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--quick") == 0)
+			options.Quick = true;
+		else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else
+		{
+			printf("Usage: %s [--quick] [--json <file>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Report report;
+	RunDatagramBenchmark(report, options);
+	RunEchoBenchmark(report, options);
+	RunRelayBenchmark(report, options);
+	RunWriterBenchmark(report, options);
+	RunArenaBenchmark(report, options);
+
+	if (json != nullptr && !report.WriteJson(json))
+	{
+		printf("Failed to write %s\n", json);
+		return 1;
+	}
+	return 0;
+}
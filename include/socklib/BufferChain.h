@@ -0,0 +1,154 @@
+#pragma once
+
+#include <socklib/BufferPool.h>
+#include <deque>
+#include <vector>
+
+namespace socklib {
+
+	/**
+	* @brief Immutable sequence of bytes made of slices of pooled buffers
+	* @details Copies, slices and concatenations share the memory instead of copying it, so the
+	*	same payload can be queued on any number of sockets: every queue keeps its own copy of the
+	*	chain and the buffers go back to the BufferPool once the last copy is gone.
+	*	The bytes must not be modified once they are part of a chain.
+	*/
+	class BufferChain {
+	public:
+
+		/**
+		* @brief A range of bytes of a single pooled buffer
+		*/
+		struct Segment {
+			PooledBuffer Buffer;
+			size_t Offset = 0;
+			size_t Length = 0;
+
+			[[nodiscard]] const BYTE* Data() const noexcept { return Buffer.Data() + Offset; }
+		};
+
+		//Constructor(s) & Destructor
+		BufferChain() noexcept = default;
+
+		/**
+		* @brief Adopts the first bytes of a buffer that was filled already
+		* @param buffer The buffer, which must not be written to anymore
+		* @param length Number of bytes of the buffer that are part of the chain
+		*/
+		BufferChain(PooledBuffer buffer, size_t length) noexcept;
+
+		/**
+		* @brief Creates a chain by copying data into pooled buffers
+		* @param data Pointer to the data that will be copied
+		* @param length Number of bytes that will be copied
+		* @return The chain, which is empty if the memory couldn't be allocated
+		*/
+		[[nodiscard]] static BufferChain Copy(const void* data, size_t length) noexcept;
+
+		/**
+		* @brief Adds the bytes of another chain at the end, sharing their memory
+		*/
+		void Append(const BufferChain& other) noexcept;
+
+		/**
+		* @brief Creates a chain of a range of the bytes, sharing their memory
+		* @param offset Index of the first byte of the range
+		* @param length Number of bytes of the range, clamped to the end of the chain
+		*/
+		[[nodiscard]] BufferChain Slice(size_t offset, size_t length) const noexcept;
+
+		/**
+		* @brief Describes the bytes from an offset on for a vectored send
+		* @param offset Number of bytes to skip
+		* @param[out] buffers Filled with the segments, in order
+		* @return The number of buffers that were filled
+		*/
+		size_t Fill(size_t offset, std::span<IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Getter for the total number of bytes
+		*/
+		[[nodiscard]] size_t Size() const noexcept { return mSize; }
+
+		[[nodiscard]] bool Empty() const noexcept { return mSize == 0; }
+
+		[[nodiscard]] std::span<const Segment> Segments() const noexcept { return mSegments; }
+
+	private:
+
+		std::vector<Segment> mSegments;
+
+		size_t mSize = 0;
+
+	};
+
+	/**
+	* @brief Queue of BufferChains waiting to be sent on a stream socket
+	* @details Send() hands as many queued bytes as possible to a single vectored send and drops
+	*	the chains that went out, which releases their buffers if no other queue holds them.
+	*	Works with non-blocking sockets: whatever the socket doesn't take stays queued for the
+	*	next call, without copying it.
+	*/
+	class SendQueue {
+	public:
+
+		/**
+		* @brief Buffers handed to a single send, at most
+		*/
+		static constexpr size_t MAX_BUFFERS = 64;
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Queues chains for a connected stream socket
+		* @param sock The socket that will be used for sending
+		*/
+		explicit SendQueue(Socket sock) noexcept;
+		SendQueue(const SendQueue&) = delete;
+		~SendQueue() noexcept = default;
+
+		/**
+		* @brief Adds a chain at the end of the queue, nothing is sent until Send()
+		*/
+		void Push(BufferChain chain) noexcept;
+
+		/**
+		* @brief Sends queued bytes until the queue is empty or the socket can't take more
+		* @return Number of bytes that were sent, or the error code of the failure (a socket that
+		*	can't take any byte gives an error for which WouldBlock() is true)
+		*/
+		Result<size_t> Send() noexcept;
+
+		/**
+		* @brief Getter for the number of bytes that are queued but not sent yet
+		*/
+		[[nodiscard]] size_t Pending() const noexcept { return mPending; }
+
+		/**
+		* @brief Getter for the number of chains that are at least partially unsent
+		*/
+		[[nodiscard]] size_t Queued() const noexcept { return mChains.size(); }
+
+		[[nodiscard]] bool Empty() const noexcept { return mChains.empty(); }
+
+		[[nodiscard]] const Socket& GetSocket() const noexcept { return mSock; }
+
+		SendQueue& operator=(const SendQueue&) = delete;
+
+	private:
+
+		void Consume(size_t bytes) noexcept;
+
+	private:
+
+		Socket mSock;
+
+		std::deque<BufferChain> mChains;
+
+		//Bytes of the front chain that were sent already
+		size_t mOffset = 0;
+
+		size_t mPending = 0;
+
+	};
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <socklib/Socket.h>
+#include <atomic>
+#include <span>
+
+namespace socklib {
+
+	/**
+	* @brief Reference counted handle to a buffer of the BufferPool
+	* @details Copies share the same memory, which goes back to the pool once the last handle
+	*	is destroyed or reset, on whatever thread that happens.
+	*/
+	class PooledBuffer {
+	public:
+
+		//Constructor(s) & Destructor
+		PooledBuffer() noexcept = default;
+		PooledBuffer(const PooledBuffer& other) noexcept;
+		PooledBuffer(PooledBuffer&& other) noexcept;
+		~PooledBuffer() noexcept { Reset(); }
+
+		/**
+		* @brief Getter for the memory of the buffer
+		*/
+		[[nodiscard]] BYTE* Data() const noexcept { return mBlock != nullptr ? reinterpret_cast<BYTE*>(mBlock + 1) : nullptr; }
+
+		/**
+		* @brief Getter for the number of usable bytes, the size class the request was rounded up to
+		*/
+		[[nodiscard]] size_t Size() const noexcept { return mBlock != nullptr ? mBlock->Size : 0; }
+
+		[[nodiscard]] std::span<BYTE> Span() const noexcept { return { Data(), Size() }; }
+
+		/**
+		* @brief Getter for the number of handles sharing the buffer
+		*/
+		[[nodiscard]] uint32_t UseCount() const noexcept { return mBlock != nullptr ? mBlock->Refs.load(std::memory_order_relaxed) : 0; }
+
+		/**
+		* @brief Checks whether the handle refers to a buffer
+		*/
+		[[nodiscard]] bool IsValid() const noexcept { return mBlock != nullptr; }
+
+		/**
+		* @brief Lets go of the buffer, returning it to the pool if this was the last handle
+		*/
+		void Reset() noexcept;
+
+		PooledBuffer& operator=(const PooledBuffer& rhs) noexcept;
+
+		PooledBuffer& operator=(PooledBuffer&& rhs) noexcept;
+
+	private:
+
+		friend class BufferPool;
+
+		//Header in front of the memory of every buffer, a cache line so the memory stays aligned
+		struct alignas(64) Block {
+			std::atomic<uint32_t> Refs;
+			uint32_t Class;
+			size_t Size;
+			//Carved out of an arena, so it is never freed on its own
+			bool Arena = false;
+		};
+
+		explicit PooledBuffer(Block* block) noexcept
+			: mBlock(block) {}
+
+	private:
+
+		Block* mBlock = nullptr;
+
+	};
+
+	/**
+	* @brief Kind of pages backing an arena reserved by the BufferPool
+	*/
+	enum class ArenaPages : uint8_t {
+		Normal,
+		/**
+		* @brief Transparent huge pages, requested with madvise(MADV_HUGEPAGE); the kernel may
+		*	still back parts of the arena with normal pages
+		*/
+		Transparent,
+		/**
+		* @brief Pages of the hugetlbfs pool, mapped with MAP_HUGETLB
+		*/
+		Huge
+	};
+
+	/**
+	* @brief Settings of BufferPool::Reserve()
+	*/
+	struct ArenaOptions {
+		/**
+		* @brief Tries MAP_HUGETLB, then MADV_HUGEPAGE, before settling for normal pages.
+		*	Only supported on Linux.
+		*/
+		bool HugePages = true;
+		/**
+		* @brief Touches every page of the arena right away, so first uses don't page fault
+		*/
+		bool Prefault = true;
+	};
+
+	/**
+	* @brief Process wide pool of I/O buffers
+	* @details Requests are rounded up to one of a few size classes, and released buffers are kept
+	*	for reuse instead of going back to the allocator. Every thread keeps a small cache per
+	*	class which it uses without any synchronization, only refilling it from (or spilling it
+	*	into) the shared lists in batches, under a lock. Requests larger than the largest class
+	*	are allocated and freed directly.
+	*	There is a single pool per process rather than instances: the caches of the threads
+	*	live as long as the threads and have to hand their buffers back to something that is
+	*	still around when they exit.
+	*/
+	class BufferPool {
+	public:
+
+		/**
+		* @brief The sizes buffers are rounded up to
+		*/
+		static constexpr size_t SIZE_CLASSES[] = { 2 * KiB, 16 * KiB, 64 * KiB, MiB };
+
+		/**
+		* @brief Counters for sizing the pool, summed over every thread
+		*/
+		struct Stats {
+			/**
+			* @brief Requests served with a buffer that was kept for reuse
+			*/
+			uint64_t Hits = 0;
+			/**
+			* @brief Requests that had to allocate
+			*/
+			uint64_t Misses = 0;
+			/**
+			* @brief Bytes of the buffers that are currently handed out
+			*/
+			int64_t Outstanding = 0;
+			/**
+			* @brief Bytes of the buffers that are kept for reuse
+			*/
+			int64_t Cached = 0;
+			/**
+			* @brief Bytes of the arenas mapped by Reserve()
+			*/
+			int64_t Reserved = 0;
+		};
+
+		BufferPool() = delete;
+
+		/**
+		* @brief Hands out a buffer of at least the given size
+		* @param size Minimum number of bytes
+		* @return The buffer, which is invalid if the memory couldn't be allocated
+		*/
+		[[nodiscard]] static PooledBuffer Acquire(size_t size) noexcept;
+
+		/**
+		* @brief Maps an arena and fills the pool with buffers carved out of it
+		* @details Meant to be called at startup: a few large mappings backed by huge pages take far
+		*	fewer TLB entries than buffers allocated one by one, and prefaulting moves the page faults
+		*	out of the first requests. The arena is rounded up to whole huge pages and every byte of
+		*	it becomes buffers, so there may be more of them than asked for. Arenas are never unmapped.
+		* @param size Size of the buffers, rounded up to its size class like Acquire()
+		* @param count Minimum number of buffers
+		* @param options Settings of the arena
+		* @return The kind of pages backing the arena, or the error code of the failure
+		*/
+		static Result<ArenaPages> Reserve(size_t size, size_t count, const ArenaOptions& options = {}) noexcept;
+
+		[[nodiscard]] static Stats GetStats() noexcept;
+
+		/**
+		* @brief Frees the buffers kept in the shared lists, the caches of the threads are left alone
+		*	and so are the buffers of the arenas
+		*/
+		static void Trim() noexcept;
+
+	private:
+
+		friend class PooledBuffer;
+
+		static void Release(PooledBuffer::Block* block) noexcept;
+
+	};
+
+}
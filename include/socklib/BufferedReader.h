@@ -0,0 +1,125 @@
+#pragma once
+
+#include <socklib/RingBuffer.h>
+#include <string_view>
+
+namespace socklib {
+
+	/**
+	* @brief Reads a stream socket in large chunks and hands out the bytes frame by frame
+	* @details Every receive asks for all the free space of a RingBuffer, so parsing a protocol
+	*	field by field costs one system call per chunk instead of one per field. Frames are
+	*	returned as views into the buffer, which is contiguous even when a frame wraps around,
+	*	so nothing is copied. A view stays valid until the next non-const call on the reader.
+	*	The reader works on both blocking and non-blocking sockets: when the socket has nothing
+	*	to offer yet (or a receive timeout expired) the call fails with an error for which
+	*	WouldBlock() is true, the bytes that already arrived are kept and the same call can be
+	*	repeated once the socket is readable again.
+	*	When the peer shuts down before a frame is complete, the call fails with
+	*	std::errc::no_message and IsEndOfStream() becomes true.
+	*/
+	class BufferedReader {
+	public:
+
+		static constexpr size_t DEFAULT_CAPACITY = 64 * KiB;
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Wraps a connected stream socket
+		* @param sock The socket to read from
+		* @param capacity Minimum number of bytes that can be buffered, which is also the size of the largest frame
+		*/
+		explicit BufferedReader(Socket sock, size_t capacity = DEFAULT_CAPACITY) noexcept;
+		BufferedReader(const BufferedReader&) = delete;
+		BufferedReader(BufferedReader&&) noexcept = default;
+		~BufferedReader() noexcept = default;
+
+		/**
+		* @brief Returns the next bytes of the stream without consuming them
+		* @param length Number of bytes to look at
+		* @return A view of exactly length bytes, or the error code of the failure
+		*	(std::errc::message_size if length doesn't fit into the buffer)
+		*/
+		Result<std::span<const BYTE>> Peek(size_t length) noexcept;
+
+		/**
+		* @brief Reads exactly the given number of bytes
+		* @param length Number of bytes to read
+		* @return A view of exactly length bytes, or the error code of the failure
+		*	(std::errc::message_size if length doesn't fit into the buffer)
+		*/
+		Result<std::span<const BYTE>> ReadExact(size_t length) noexcept;
+
+		/**
+		* @brief Reads up to and including the first occurrence of a delimiter
+		* @param delimiter The bytes that end the frame, e.g. "\r\n"
+		* @return A view of the frame, delimiter included, or the error code of the failure
+		*	(std::errc::message_size if the buffer got full before the delimiter showed up)
+		*/
+		Result<std::span<const BYTE>> ReadUntil(std::string_view delimiter) noexcept;
+
+		/**
+		* @brief Copies out whatever is available, up to the given number of bytes
+		* @details Receives only if nothing is buffered
+		* @param[out] data Pointer to the buffer that receives the bytes
+		* @param length Maximum number of bytes that will be read
+		* @return The number of bytes that were read (0 at the end of the stream), or the error code of the failure
+		*/
+		Result<size_t> Read(void* data, size_t length) noexcept;
+
+		/**
+		* @brief Getter for the size of the largest frame
+		*/
+		[[nodiscard]] size_t Capacity() const noexcept { return mBuffer.Capacity(); }
+
+		/**
+		* @brief Getter for the number of bytes that were received but not read yet
+		*/
+		[[nodiscard]] size_t Buffered() const noexcept { return mBuffer.Size(); }
+
+		/**
+		* @brief Checks whether the peer has shut down its sending direction
+		* @details Bytes may still be buffered, see Buffered()
+		*/
+		[[nodiscard]] bool IsEndOfStream() const noexcept { return mEndOfStream; }
+
+		/**
+		* @brief Checks whether the buffer was mapped successfully
+		*/
+		[[nodiscard]] bool IsValid() const noexcept { return mBuffer.IsValid(); }
+
+		/**
+		* @brief Getter for the number of system calls made to receive data
+		*/
+		[[nodiscard]] uint64_t Receives() const noexcept { return mReceives; }
+
+		[[nodiscard]] const Socket& GetSocket() const noexcept { return mSock; }
+
+		BufferedReader& operator=(const BufferedReader&) = delete;
+
+		BufferedReader& operator=(BufferedReader&&) noexcept = default;
+
+	private:
+
+		//Receives until at least length bytes are buffered
+		Result<void> Fill(size_t length) noexcept;
+
+		//Receives once into the free space
+		Result<void> ReceiveMore() noexcept;
+
+	private:
+
+		Socket mSock;
+
+		RingBuffer mBuffer;
+
+		//Number of buffered bytes that ReadUntil() already searched, so they aren't searched again
+		size_t mScanned = 0;
+
+		bool mEndOfStream = false;
+
+		uint64_t mReceives = 0;
+
+	};
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <socklib/BufferPool.h>
+#include <chrono>
+
+namespace socklib {
+
+	/**
+	* @brief Settings of a BufferedWriter
+	*/
+	struct BufferedWriterOptions {
+		/**
+		* @brief Buffered bytes that trigger a send, writes of at least this size skip the buffer
+		*/
+		size_t Threshold = 16 * KiB;
+		/**
+		* @brief Longest time a byte waits in the buffer, checked by Write() and FlushIfDue(),
+		*	zero means only the threshold and Flush() send
+		*/
+		std::chrono::microseconds Delay = std::chrono::microseconds::zero();
+		/**
+		* @brief Keeps partial TCP segments in the kernel until Flush()
+		* @details Sends triggered by the threshold use MSG_MORE on Linux, the rest of the Unix-Like
+		*	systems cork the socket with TCP_NOPUSH instead. Not supported on Windows.
+		*/
+		bool Cork = false;
+	};
+
+	/**
+	* @brief Coalesces many small writes to a stream socket into few system calls
+	* @details Small writes are copied into a buffer from the BufferPool that is sent once it reaches the threshold,
+	*	once the oldest byte is older than the delay or when Flush() is called. Large writes are
+	*	sent together with whatever is buffered in a single vectored send, without copying them.
+	*	Besides the system calls this also saves the many tiny TCP segments that each write would
+	*	otherwise become.
+	*	Write() never fails because the socket can't take more bytes: on a non-blocking socket
+	*	whatever isn't sent stays buffered (the buffer grows as needed) and Flush() fails with an
+	*	error for which WouldBlock() is true until everything is out.
+	*	Buffered bytes are flushed once more by the destructor, ignoring failures.
+	*/
+	class BufferedWriter {
+	public:
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Wraps a connected stream socket
+		* @param sock The socket to write to
+		* @param options Settings of the writer
+		*/
+		explicit BufferedWriter(Socket sock, const BufferedWriterOptions& options = {}) noexcept;
+		BufferedWriter(const BufferedWriter&) = delete;
+		~BufferedWriter() noexcept;
+
+		/**
+		* @brief Queues data, sending it if the threshold or the delay is reached
+		* @param data Pointer to the data that will be written
+		* @param length Number of bytes that will be written
+		* @return Nothing, or the error code of a failed send (ENOMEM if the bytes that have to be
+		*	buffered don't fit and no larger buffer could be had)
+		*/
+		Result<void> Write(const void* data, size_t length) noexcept;
+
+		/**
+		* @brief Sends every buffered byte right away
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> Flush() noexcept;
+
+		/**
+		* @brief Flushes if the oldest buffered byte has waited for longer than the delay
+		* @details Meant for event loops, which can use Deadline() as their timeout
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> FlushIfDue() noexcept;
+
+		/**
+		* @brief Getter for the number of bytes that were written but not sent yet
+		*/
+		[[nodiscard]] size_t Buffered() const noexcept { return mEnd - mStart; }
+
+		/**
+		* @brief Getter for the time by which the buffered bytes should be flushed
+		* @details Only meaningful while something is buffered and the delay isn't zero
+		*/
+		[[nodiscard]] std::chrono::steady_clock::time_point Deadline() const noexcept { return mOldest + mOptions.Delay; }
+
+		/**
+		* @brief Getter for the number of system calls made to send data
+		*/
+		[[nodiscard]] uint64_t Sends() const noexcept { return mSends; }
+
+		[[nodiscard]] const Socket& GetSocket() const noexcept { return mSock; }
+
+		BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+	private:
+
+		[[nodiscard]] bool IsDue() const noexcept;
+
+		Result<void> Append(const void* data, size_t length) noexcept;
+
+		void Consume(size_t bytes) noexcept;
+
+		//Sends until the buffer is empty, more tells the kernel that more bytes will follow soon
+		Result<void> Drain(bool more) noexcept;
+
+		Result<size_t> SendBuffers(std::span<const IOBuffer> buffers, bool more) noexcept;
+
+		//Enables the cork, if the platform corks the socket itself
+		void Cork() const noexcept;
+
+		//Pushes out a partial segment that was held back
+		void Push() noexcept;
+
+	private:
+
+		Socket mSock;
+
+		BufferedWriterOptions mOptions;
+
+		PooledBuffer mBuffer;
+
+		//Offset of the first byte that wasn't sent yet
+		size_t mStart = 0;
+
+		//Offset past the last buffered byte
+		size_t mEnd = 0;
+
+		std::chrono::steady_clock::time_point mOldest;
+
+		//Whether the kernel may be holding back a partial segment
+		bool mHeld = false;
+
+		uint64_t mSends = 0;
+
+	};
+
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <socklib/Socket.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace socklib {
+
+	class PooledConnection;
+
+	/**
+	* @brief Settings of a ConnectionPool, the limits apply to every endpoint on its own
+	*/
+	struct ConnectionPoolOptions {
+		/**
+		* @brief Connections kept open while nobody uses them, the rest are closed when released
+		*/
+		size_t MaxIdle = 8;
+		/**
+		* @brief Connections open at once, idle and in use together
+		*/
+		size_t MaxTotal = 64;
+		/**
+		* @brief Idle connections older than this are closed instead of being handed out
+		*/
+		std::chrono::milliseconds IdleTimeout = std::chrono::seconds(60);
+		/**
+		* @brief Milliseconds a new connection may take, 0 means no limit
+		*/
+		uint32_t ConnectTimeout = 0;
+	};
+
+	/**
+	* @brief Keeps client connections to backends open between requests
+	* @details Connections are grouped by the address of their endpoint. Acquire() hands out the most
+	*	recently released idle connection, after a cheap health check: a non-blocking peek that
+	*	finds the peer closed it (or sent something nobody asked for) closes it and tries the next.
+	*	Only when there is none left a new connection is opened, so the handshake is paid once per
+	*	connection rather than once per request.
+	*	Idle connections are kept in shards that each have their own lock, and a thread releases
+	*	into and leases from its own shard first, so threads talking to the same backend rarely
+	*	contend. Only when its shard has none a lease looks at the ones other threads released.
+	*	The pool must outlive the connections it leased.
+	*/
+	class ConnectionPool {
+	public:
+
+		/**
+		* @brief Counters of how the leases were served
+		*/
+		struct Stats {
+			/**
+			* @brief Leases served with an idle connection
+			*/
+			uint64_t Hits = 0;
+			/**
+			* @brief Leases that opened a new connection
+			*/
+			uint64_t Misses = 0;
+			/**
+			* @brief Idle connections that were closed because they expired or failed the health check
+			*/
+			uint64_t Evicted = 0;
+		};
+
+		//Constructor(s) & Destructor
+		explicit ConnectionPool(const ConnectionPoolOptions& options = {}) noexcept;
+		ConnectionPool(const ConnectionPool&) = delete;
+		~ConnectionPool() noexcept = default;
+
+		/**
+		* @brief Leases a connection to an endpoint, opening one if no idle one is healthy
+		* @param address Socket address of the backend
+		* @return The connection, or the error code of the failed connect (WouldBlock() is true if
+		*	MaxTotal connections to the endpoint are in use already)
+		*/
+		[[nodiscard]] Result<PooledConnection> Acquire(const SocketAddress& address) noexcept;
+
+		/**
+		* @brief Opens idle connections ahead of the first requests
+		* @details The connects of all the endpoints run concurrently on a single thread, so startup
+		*	takes about one handshake instead of one per connection
+		* @param addresses Socket addresses of the backends
+		* @param count Connections to open per endpoint, limited by MaxIdle and MaxTotal
+		* @param timeout Milliseconds the connects may take, 0 means no limit
+		* @return The number of connections that were opened
+		*/
+		size_t WarmUp(std::span<const SocketAddress> addresses, size_t count, uint32_t timeout = 0) noexcept;
+
+		/**
+		* @brief Closes the idle connections that are older than the idle timeout
+		* @details Acquire() skips expired connections anyway, this gives their resources back sooner
+		* @return The number of connections that were closed
+		*/
+		size_t EvictIdle() noexcept;
+
+		/**
+		* @brief Getter for the number of idle connections to an endpoint
+		*/
+		[[nodiscard]] size_t Idle(const SocketAddress& address) noexcept;
+
+		/**
+		* @brief Getter for the number of connections to an endpoint, idle and in use
+		*/
+		[[nodiscard]] size_t Total(const SocketAddress& address) noexcept;
+
+		/**
+		* @brief Getter for the number of endpoints that have connections, idle or in use
+		*/
+		[[nodiscard]] size_t Endpoints() noexcept;
+
+		[[nodiscard]] Stats GetStats() const noexcept;
+
+		[[nodiscard]] const ConnectionPoolOptions& GetOptions() const noexcept { return mOptions; }
+
+		ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+	private:
+
+		static constexpr size_t SHARDS = 16;
+
+		struct IdleConnection {
+			Socket Sock;
+			std::chrono::steady_clock::time_point Since;
+		};
+
+		//The limits of an endpoint, shared by its idle lists and leased connections and gone with the last of them
+		struct Endpoint {
+			std::atomic<size_t> Total = 0;
+			std::atomic<size_t> Idle = 0;
+		};
+
+		//The idle connections to an endpoint that were released into one shard
+		struct IdleList {
+			//Oldest first, leases take the most recently released one
+			std::vector<IdleConnection> Connections;
+			std::shared_ptr<Endpoint> Owner;
+		};
+
+		struct alignas(64) Shard {
+			std::mutex Mutex;
+			std::unordered_map<SocketAddress, IdleList> Lists;
+		};
+
+		//Finds the Endpoint of an address, only touched when connections are opened
+		struct alignas(64) Directory {
+			std::mutex Mutex;
+			std::unordered_map<SocketAddress, std::weak_ptr<Endpoint>> Endpoints;
+		};
+
+		friend class PooledConnection;
+
+		//Each stripe puts an endpoint on a different shard, a thread looks at the one of its own stripe first
+		[[nodiscard]] Shard& ShardOf(const SocketAddress& address, const size_t stripe) noexcept { return mShards[(address.Hash() + stripe) % SHARDS]; }
+
+		[[nodiscard]] Directory& DirectoryOf(const SocketAddress& address) noexcept { return mDirectories[address.Hash() % SHARDS]; }
+
+		//Finds the Endpoint of an address, creating it if nothing is connected to it
+		[[nodiscard]] std::shared_ptr<Endpoint> Open(const SocketAddress& address) noexcept;
+
+		[[nodiscard]] std::shared_ptr<Endpoint> Find(const SocketAddress& address) noexcept;
+
+		//Erases the Directory entry of an Endpoint that is gone
+		void Forget(const SocketAddress& address) noexcept;
+
+		//Counts up to wanted new connections against MaxTotal, returns how many it could
+		[[nodiscard]] size_t Reserve(Endpoint& endpoint, size_t wanted) const noexcept;
+
+		//Takes the most recently released idle connection of a shard that hasn't expired, the list is erased once it is empty
+		bool Take(Shard& shard, const SocketAddress& address, Socket& sock, std::shared_ptr<Endpoint>& endpoint) noexcept;
+
+		//Drops the expired connections from the front of the idle list, the caller holds the lock
+		size_t Expire(IdleList& list, std::chrono::steady_clock::time_point now) noexcept;
+
+		void Return(Socket sock, std::shared_ptr<Endpoint> endpoint, const SocketAddress& address, bool reusable) noexcept;
+
+	private:
+
+		ConnectionPoolOptions mOptions;
+
+		//Declared first, the idle lists reach it while they are destroyed
+		std::unique_ptr<Directory[]> mDirectories;
+
+		std::unique_ptr<Shard[]> mShards;
+
+		std::atomic<uint64_t> mHits = 0;
+		std::atomic<uint64_t> mMisses = 0;
+		std::atomic<uint64_t> mEvicted = 0;
+
+	};
+
+	/**
+	* @brief A connection leased from a ConnectionPool
+	* @details Goes back to the pool when it is destroyed or released, unless it was discarded.
+	*	Only connections that are ready for the next request should go back: discard the ones whose
+	*	response wasn't read completely or that failed.
+	*/
+	class PooledConnection {
+	public:
+
+		//Constructor(s) & Destructor
+		PooledConnection() noexcept = default;
+		PooledConnection(const PooledConnection&) = delete;
+		PooledConnection(PooledConnection&& other) noexcept;
+		~PooledConnection() noexcept { Release(); }
+
+		/**
+		* @brief Returns the connection to the pool, the handle is left empty
+		*/
+		void Release() noexcept;
+
+		/**
+		* @brief Closes the connection instead of returning it, the handle is left empty
+		*/
+		void Discard() noexcept;
+
+		[[nodiscard]] const Socket& GetSocket() const noexcept { return mSock; }
+
+		[[nodiscard]] const SocketAddress& GetAddress() const noexcept { return mAddress; }
+
+		/**
+		* @brief Checks whether the connection was kept from an earlier lease rather than opened for this one
+		*/
+		[[nodiscard]] bool IsReused() const noexcept { return mReused; }
+
+		[[nodiscard]] bool IsValid() const noexcept { return mPool != nullptr; }
+
+		PooledConnection& operator=(const PooledConnection&) = delete;
+
+		PooledConnection& operator=(PooledConnection&& rhs) noexcept;
+
+	private:
+
+		friend class ConnectionPool;
+
+		PooledConnection(ConnectionPool* pool, Socket sock, const SocketAddress& address, std::shared_ptr<ConnectionPool::Endpoint> endpoint, const bool reused) noexcept
+			: mPool(pool), mSock(std::move(sock)), mAddress(address), mEndpoint(std::move(endpoint)), mReused(reused) {}
+
+	private:
+
+		ConnectionPool* mPool = nullptr;
+
+		Socket mSock;
+
+		SocketAddress mAddress;
+
+		std::shared_ptr<ConnectionPool::Endpoint> mEndpoint;
+
+		bool mReused = false;
+
+	};
+
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <socklib/Poller.h>
+#include <deque>
+
+namespace socklib {
+
+	/**
+	* @brief Outcome of an operation submitted to an IOEngine
+	*/
+	struct Completion {
+		/**
+		* @brief Number of bytes transferred (0 for Accept) or -1 on failure
+		*/
+		IOSize Result = 0;
+		/**
+		* @brief Native error code when the operation failed
+		*/
+		int Error = 0;
+		/**
+		* @brief The new connection (only set by Accept operations)
+		*/
+		Socket Client;
+		/**
+		* @brief Received data when the engine picked the buffer (only set by multishot Receive)
+		* @warning The buffer is given back to the engine once the handler returns
+		*/
+		const BYTE* Data = nullptr;
+		/**
+		* @brief True if the operation is multishot and is going to complete again
+		*/
+		bool More = false;
+	};
+
+	/**
+	* @brief Completion based I/O engine
+	* @details Accept, Receive and Send are submitted as operations and their handlers
+	*	are invoked from Poll() once they complete. On Linux the engine is backed by io_uring
+	*	(through raw system calls) so a single system call can both submit and reap many
+	*	operations, and multishot operations keep completing without being resubmitted.
+	*	When io_uring is not available (old kernels, seccomp filters, other platforms) it
+	*	falls back to a Poller that performs the same system calls on readiness, so code
+	*	written against it doesn't need to care which one is in use.
+	*	Sockets must stay open until all of their operations have completed.
+	*/
+	class IOEngine {
+	public:
+
+		/**
+		* @brief Callback invoked when an operation completes
+		*/
+		using Handler = std::function<void(Completion&)>;
+
+		//Constructor(s) & Destructor
+		IOEngine(const IOEngine&) = delete;
+		~IOEngine() noexcept;
+
+		/**
+		* @brief Constructs an engine
+		* @param entries Size of the submission queue (ignored by the fallback engine)
+		* @param useIOUring Whether io_uring should be used if it is available
+		*/
+		explicit IOEngine(uint32_t entries = 256, bool useIOUring = true) noexcept;
+
+		/**
+		* @brief Allocates the buffers that multishot Receive operations pick from
+		* @details If the kernel can't register a buffer ring the engine switches to the
+		*	fallback Poller, which is only possible while no operations are pending.
+		* @param count Number of buffers (must be a power of two)
+		* @param size Size in bytes of every buffer
+		* @return False if the buffers couldn't be registered, in which case ReceiveMultishot() can't be used
+		* @warning Must be called (once) before any ReceiveMultishot()
+		*/
+		bool ProvideBuffers(uint32_t count, size_t size) noexcept;
+
+		/**
+		* @brief Submits an Accept operation
+		* @param listener A listening Socket
+		* @param handler Callback that receives the new connection, close-on-exec with either backend
+		*/
+		void Accept(const Socket& listener, Handler handler) noexcept;
+
+		/**
+		* @brief Submits an Accept operation that completes once for every new connection
+		* @param listener A listening Socket
+		* @param handler Callback that receives the new connections, close-on-exec with either backend
+		*/
+		void AcceptMultishot(const Socket& listener, Handler handler) noexcept;
+
+		/**
+		* @brief Submits a Receive operation
+		* @param sock A connected Socket
+		* @param data Pointer to the buffer that will hold the data (must outlive the operation)
+		* @param length Size of the buffer
+		* @param handler Callback that receives the number of bytes received
+		*/
+		void Receive(const Socket& sock, void* data, size_t length, Handler handler) noexcept;
+
+		/**
+		* @brief Submits a Receive operation that completes every time data arrives
+		* @details Data is placed in one of the buffers given with ProvideBuffers(). The operation
+		*	ends (Completion::More is false) on end of stream, on error or when no buffers are left.
+		* @param sock A connected Socket
+		* @param handler Callback that receives the data
+		*/
+		void ReceiveMultishot(const Socket& sock, Handler handler) noexcept;
+
+		/**
+		* @brief Submits a Send operation
+		* @param sock A connected Socket
+		* @param data Pointer to the data that will be sent (must outlive the operation)
+		* @param length Number of bytes that will be sent
+		* @param handler Callback that receives the number of bytes that were actually sent
+		*/
+		void Send(const Socket& sock, const void* data, size_t length, Handler handler) noexcept;
+
+		/**
+		* @brief Submits the queued operations, waits for completions and dispatches their handlers
+		* @param millis Milliseconds to wait before giving up, a negative value means wait forever
+		* @return The number of completions that were dispatched
+		*/
+		size_t Poll(int32_t millis = -1) noexcept;
+
+		/**
+		* @brief Getter for the number of operations that haven't completed yet
+		* @return The number of pending operations
+		*/
+		[[nodiscard]] size_t Pending() const noexcept { return mOperations.size() - mFreeOperations.size(); }
+
+		/**
+		* @brief Checks whether the engine is backed by io_uring or by the fallback Poller
+		* @return True if io_uring is in use
+		*/
+		[[nodiscard]] bool UsesIOUring() const noexcept { return mRing != nullptr; }
+
+		IOEngine& operator=(const IOEngine&) = delete;
+
+	private:
+
+		enum class OperationType : uint8_t { ACCEPT, RECEIVE, SEND };
+
+		struct Operation {
+			OperationType Type = OperationType::ACCEPT;
+			bool Multishot = false;
+			bool Blocking = true;
+			AddressFamily Family = AddressFamily::UNSPECIFIED;
+			SOCKET Sock = INVALID_SOCKET;
+			void* Data = nullptr;
+			size_t Length = 0;
+			Handler Callback;
+		};
+
+		struct Ring;
+
+		//Per socket queues of operations waiting for readiness (fallback engine)
+		struct Waiting {
+			std::deque<uint32_t> Readers;
+			std::deque<uint32_t> Writers;
+		};
+
+		void Submit(OperationType type, const Socket& sock, void* data, size_t length, bool multishot, Handler handler) noexcept;
+
+		void Complete(uint32_t id, Completion& completion) noexcept;
+
+		static Socket Adopt(SOCKET sock, AddressFamily family) noexcept;
+
+		//io_uring engine
+		void Enqueue(uint32_t id) noexcept;
+
+		size_t Reap() noexcept;
+
+		void RecycleBuffer(uint16_t bid) noexcept;
+
+		//Fallback engine
+		void Wait(uint32_t id) noexcept;
+
+		void OnReady(SOCKET sock, PollEvent events) noexcept;
+
+		bool Perform(uint32_t id, Completion& completion) noexcept;
+
+	private:
+
+		//Deque so operations don't move while their handlers run
+		std::deque<Operation> mOperations;
+
+		std::vector<uint32_t> mFreeOperations;
+
+		std::unique_ptr<Ring> mRing;
+
+		std::vector<BYTE> mBuffers;
+
+		size_t mBufferSize = 0;
+
+		uint32_t mBufferCount = 0;
+
+		Poller mPoller;
+
+		std::unordered_map<SOCKET, Waiting> mWaiting;
+
+		size_t mDispatched = 0;
+
+	};
+
+}
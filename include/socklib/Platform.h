@@ -6,6 +6,10 @@
 	#define PLATFORM_WINDOWS
 #elif defined(__unix__) || defined(__unix)
 	#define PLATFORM_UNIX
+	#ifdef __linux__
+		/* Linux specific facilities (epoll etc.) */
+		#define PLATFORM_LINUX
+	#endif
 #else
 	/* Not supported Platform */
 	#error "Platform not Supported!"
@@ -48,6 +52,10 @@
 	#include <unistd.h>
 	#include <fcntl.h>
 	#include <sys/ioctl.h>
+	#include <poll.h>
+	#ifdef PLATFORM_LINUX
+		#include <sys/epoll.h>
+	#endif
 	//Extra macro definition
 	#define INVALID_SOCKET (-1)
 	#define SOCKET_ERROR (-1)
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <socklib/Socket.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace socklib {
+
+	/**
+	* @brief Readiness events that a Poller can watch for
+	* @details FAILURE and HANGUP are always reported, there is no need to ask for them
+	*/
+	enum class PollEvent : uint32_t {
+		NONE = 0,
+		READABLE = 1 << 0,
+		WRITABLE = 1 << 1,
+		FAILURE = 1 << 2,
+		HANGUP = 1 << 3,
+	};
+
+	constexpr PollEvent operator|(const PollEvent lhs, const PollEvent rhs) noexcept { return static_cast<PollEvent>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs)); }
+	constexpr PollEvent operator&(const PollEvent lhs, const PollEvent rhs) noexcept { return static_cast<PollEvent>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs)); }
+
+	/**
+	* @brief Checks whether any of the requested events is set
+	* @param events The events that were reported
+	* @param requested The events we are interested in
+	* @return True if at least one of the requested events was reported
+	*/
+	constexpr bool HasEvent(const PollEvent events, const PollEvent requested) noexcept { return (events & requested) != PollEvent::NONE; }
+
+	/**
+	* @brief A readiness based event loop for multiplexing many sockets on a single thread
+	* @details Sockets are registered by their native file descriptor together with the events
+	*	we are interested in and a callback that is dispatched whenever they become ready.
+	*	On Linux the implementation uses epoll, on other platforms poll (or WSAPoll on Windows).
+	*	Notifications are level-triggered, so registered sockets are expected to be in non-blocking
+	*	mode (see Socket::SetBlocking) and callbacks should read/write until Send or Receive returns
+	*	-1 which is the convention for EAGAIN/EWOULDBLOCK. Registering, modifying and removing
+	*	sockets is safe from within callbacks, but a Poller is not meant to be shared across threads
+	*	with the only exceptions being Stop() and Wakeup().
+	*/
+	class Poller {
+	public:
+
+		/**
+		* @brief Callback that is invoked with the ready socket and the events that were reported
+		*/
+		using Callback = std::function<void(SOCKET, PollEvent)>;
+
+		//Constructor(s) & Destructor
+		Poller() noexcept;
+		Poller(const Poller&) = delete;
+		~Poller() noexcept;
+
+		/**
+		* @brief Registers a socket
+		* @param sock Native file descriptor of the socket
+		* @param interest Events we are interested in
+		* @param callback Function that will be invoked when any of the events occurs
+		*/
+		void Add(SOCKET sock, PollEvent interest, Callback callback) noexcept;
+
+		/**
+		* @brief Registers a socket
+		* @param sock The socket to watch
+		* @param interest Events we are interested in
+		* @param callback Function that will be invoked when any of the events occurs
+		*/
+		void Add(const Socket& sock, const PollEvent interest, Callback callback) noexcept { Add(sock.FileNo(), interest, std::move(callback)); }
+
+		/**
+		* @brief Changes the events we are interested in for an already registered socket
+		* @param sock Native file descriptor of the socket
+		* @param interest The new set of events we are interested in
+		*/
+		void Modify(SOCKET sock, PollEvent interest) noexcept;
+
+		/**
+		* @brief Changes the events we are interested in for an already registered socket
+		* @param sock The socket that is being watched
+		* @param interest The new set of events we are interested in
+		*/
+		void Modify(const Socket& sock, const PollEvent interest) noexcept { Modify(sock.FileNo(), interest); }
+
+		/**
+		* @brief Unregisters a socket
+		* @param sock Native file descriptor of the socket
+		* @warning Sockets should be removed before they are closed, a closed one is only dropped from
+		*	the bookkeeping (its descriptor may already have been reused)
+		*/
+		void Remove(SOCKET sock) noexcept;
+
+		/**
+		* @brief Unregisters a socket
+		* @param sock The socket that is being watched
+		* @warning Sockets should be removed before they are closed, a closed one is only dropped from
+		*	the bookkeeping (its descriptor may already have been reused)
+		*/
+		void Remove(const Socket& sock) noexcept { Remove(sock.FileNo()); }
+
+		/**
+		* @brief Checks whether a socket is registered
+		* @param sock Native file descriptor of the socket
+		* @return True if the socket is registered, false otherwise
+		*/
+		[[nodiscard]] bool Contains(SOCKET sock) const noexcept { return mEntries.contains(sock); }
+
+		/**
+		* @brief Getter for the number of registered sockets
+		* @return The number of registered sockets
+		*/
+		[[nodiscard]] size_t Size() const noexcept { return mEntries.size(); }
+
+		/**
+		* @brief Waits for events and dispatches the callbacks of the ready sockets
+		* @param millis Milliseconds to wait before giving up, a negative value means wait forever
+		* @return The number of callbacks that were dispatched
+		*/
+		size_t Poll(int32_t millis = -1) noexcept;
+
+		/**
+		* @brief Dispatches events until Stop() is called
+		*/
+		void Run() noexcept;
+
+		/**
+		* @brief Requests from Run() to return
+		* @details This is safe to call from any thread, if it is called before Run() then
+		*	Run() is going to return immediately
+		*/
+		void Stop() noexcept;
+
+		/**
+		* @brief Interrupts a blocking Poll() call
+		* @details This is safe to call from any thread
+		*/
+		void Wakeup() const noexcept;
+
+		Poller& operator=(const Poller&) = delete;
+
+	private:
+
+		struct Entry {
+			PollEvent Interest = PollEvent::NONE;
+			Callback Handler;
+			uint64_t Generation = 0;//Value of mGeneration when the entry was added
+		};
+
+		bool Dispatch(SOCKET sock, PollEvent events, uint64_t generation) noexcept;
+
+	private:
+
+		std::unordered_map<SOCKET, std::unique_ptr<Entry>> mEntries;
+
+		//Entries removed while dispatching, they are kept alive until dispatching is done
+		std::vector<std::unique_ptr<Entry>> mRetired;
+
+		bool mDispatching = false;
+
+		//Bumped on every Add(), so a descriptor that is reused during dispatch doesn't receive stale events
+		uint64_t mGeneration = 0;
+
+		std::atomic<bool> mStopRequested = false;
+
+	#ifdef PLATFORM_LINUX
+		int mEpoll = -1;
+
+		int mWakeFd = -1;
+
+		std::vector<epoll_event> mEvents;
+	#else
+		std::vector<pollfd> mPollFds;
+
+		std::unordered_map<SOCKET, size_t> mIndices;
+
+		std::vector<std::pair<SOCKET, PollEvent>> mReady;
+
+		#ifndef PLATFORM_WINDOWS
+			int mWakePipe[2] = { -1, -1 };
+		#endif
+	#endif
+
+	};
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <socklib/BufferPool.h>
+#include <socklib/Poller.h>
+
+namespace socklib {
+
+	/**
+	* @brief Forwards the bytes of two connected stream sockets to each other
+	* @details The building block of L4 proxies: whatever is received on one socket is sent on the
+	*	other, in both directions, driven by a Poller. On Linux the bytes are moved with splice()
+	*	through a pipe per direction, so they never reach user memory and the only cost is the
+	*	system calls; other platforms go through a buffer per direction.
+	*	When one side shuts down (or closes) its sending direction, the remaining bytes are flushed
+	*	and the other side is shut down for writing as well (SHUT_WR), while the opposite direction
+	*	keeps flowing. The relay finishes once both directions are shut down or one of the sockets
+	*	fails, both sockets are then unregistered from the Poller. They are closed together with
+	*	the Relay, unless other copies of them are still around.
+	*	Like the Poller it is driven by, a Relay must only be used from the thread of the Poller.
+	*/
+	class Relay {
+	public:
+
+		/**
+		* @brief Callback that is invoked once the relay has finished, it is allowed to destroy the Relay
+		*/
+		using Callback = std::function<void(Relay&)>;
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Starts relaying between two connected sockets
+		* @details Both sockets are switched to non-blocking mode and registered on the Poller
+		* @param poller The event loop that drives the relay
+		* @param first One of the sockets
+		* @param second The other socket
+		* @param done Optional callback that is invoked once the relay has finished
+		*/
+		Relay(Poller& poller, Socket first, Socket second, Callback done = {}) noexcept;
+		Relay(const Relay&) = delete;
+		~Relay() noexcept;
+
+		/**
+		* @brief Stops relaying right away, without invoking the callback
+		*/
+		void Close() noexcept;
+
+		/**
+		* @brief Getter for the number of bytes forwarded from the first socket to the second one
+		*/
+		[[nodiscard]] uint64_t FirstToSecond() const noexcept { return mForward.Bytes; }
+
+		/**
+		* @brief Getter for the number of bytes forwarded from the second socket to the first one
+		*/
+		[[nodiscard]] uint64_t SecondToFirst() const noexcept { return mBackward.Bytes; }
+
+		/**
+		* @brief Checks whether the relay has finished (or was closed)
+		*/
+		[[nodiscard]] bool IsFinished() const noexcept { return mFinished; }
+
+		/**
+		* @brief Getter for the failure that finished the relay, if there was one
+		*/
+		[[nodiscard]] const std::error_code& Error() const noexcept { return mError; }
+
+		Relay& operator=(const Relay&) = delete;
+
+	private:
+
+		//Bytes flowing from one socket to the other
+		struct Direction {
+			Socket* From = nullptr;
+			Socket* To = nullptr;
+			size_t Buffered = 0;
+			size_t Capacity = 0;
+			uint64_t Bytes = 0;
+			bool EndOfStream = false;
+			bool ShutDown = false;
+		#ifdef PLATFORM_LINUX
+			int Pipe[2] = { -1, -1 };
+		#else
+			PooledBuffer Buffer;
+			size_t Start = 0;
+		#endif
+		};
+
+		void OnEvent(const Socket& sock, PollEvent events) noexcept;
+
+		bool Pump(Direction& direction) noexcept;
+
+		void Watch() noexcept;
+
+		void Finish() noexcept;
+
+		void Unregister() noexcept;
+
+		static Result<void> Open(Direction& direction) noexcept;
+
+		static void Release(Direction& direction) noexcept;
+
+		//Moves bytes from the source socket into the buffer, 0 means the end of the stream
+		static Result<size_t> Fill(Direction& direction) noexcept;
+
+		//Moves buffered bytes to the destination socket
+		static Result<size_t> Drain(Direction& direction) noexcept;
+
+	private:
+
+		Poller& mPoller;
+
+		Socket mFirst;
+
+		Socket mSecond;
+
+		Callback mDone;
+
+		Direction mForward;
+
+		Direction mBackward;
+
+		PollEvent mFirstInterest = PollEvent::NONE;
+
+		PollEvent mSecondInterest = PollEvent::NONE;
+
+		bool mFinished = false;
+
+		std::error_code mError;
+
+	};
+
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <socklib/Platform.h>
+#include <cerrno>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <version>
+#ifdef __cpp_lib_expected
+	#include <expected>
+#endif
+
+namespace socklib {
+
+#ifdef __cpp_lib_expected
+	/**
+	* @brief Either a value or the std::error_code of a failed call
+	*/
+	template<typename T>
+	using Result = std::expected<T, std::error_code>;
+
+	/**
+	* @brief Wraps an std::error_code so it can be returned as a Result
+	*/
+	using Unexpected = std::unexpected<std::error_code>;
+#else
+	/**
+	* @brief Wraps an std::error_code so it can be returned as a Result
+	*/
+	class Unexpected {
+	public:
+
+		explicit Unexpected(const std::error_code error) noexcept
+			: mError(error) {}
+
+		[[nodiscard]] const std::error_code& error() const noexcept { return mError; }
+
+	private:
+
+		std::error_code mError;
+
+	};
+
+	/**
+	* @brief Either a value or the std::error_code of a failed call
+	* @details A minimal stand-in for std::expected<T, std::error_code> on standard libraries
+	*	that don't ship it yet, only the commonly used part of its interface is offered.
+	*/
+	template<typename T>
+	class Result {
+	public:
+
+		//Constructor(s)
+		template<typename U = T> requires std::is_constructible_v<T, U&&>
+		Result(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+			: mHasValue(true) { new (&mValue) T(std::forward<U>(value)); }
+
+		Result(const Unexpected& unexpected) noexcept
+			: mError(unexpected.error()) {}
+
+		Result(const Result& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+			: mError(other.mError), mHasValue(other.mHasValue) { if (mHasValue) new (&mValue) T(other.mValue); }
+
+		Result(Result&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: mError(other.mError), mHasValue(other.mHasValue) { if (mHasValue) new (&mValue) T(std::move(other.mValue)); }
+
+		~Result() noexcept { if (mHasValue) mValue.~T(); }
+
+		Result& operator=(Result rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			this->~Result();
+			return *new (this) Result(std::move(rhs));
+		}
+
+		[[nodiscard]] bool has_value() const noexcept { return mHasValue; }
+		explicit operator bool() const noexcept { return mHasValue; }
+
+		[[nodiscard]] T& value() & noexcept { SOCKLIB_ASSERT(mHasValue, "Result holds an error!"); return mValue; }
+		[[nodiscard]] const T& value() const& noexcept { SOCKLIB_ASSERT(mHasValue, "Result holds an error!"); return mValue; }
+		[[nodiscard]] T&& value() && noexcept { SOCKLIB_ASSERT(mHasValue, "Result holds an error!"); return std::move(mValue); }
+
+		[[nodiscard]] T& operator*() & noexcept { return mValue; }
+		[[nodiscard]] const T& operator*() const& noexcept { return mValue; }
+		[[nodiscard]] T&& operator*() && noexcept { return std::move(mValue); }
+		T* operator->() noexcept { return &mValue; }
+		const T* operator->() const noexcept { return &mValue; }
+
+		template<typename U>
+		[[nodiscard]] T value_or(U&& other) const& { return mHasValue ? mValue : static_cast<T>(std::forward<U>(other)); }
+
+		[[nodiscard]] const std::error_code& error() const noexcept { return mError; }
+
+	private:
+
+		union { T mValue; };
+		std::error_code mError;
+		bool mHasValue = false;
+
+	};
+
+	/**
+	* @brief Either nothing or the std::error_code of a failed call
+	*/
+	template<>
+	class Result<void> {
+	public:
+
+		//Constructor(s)
+		Result() noexcept = default;
+
+		Result(const Unexpected& unexpected) noexcept
+			: mError(unexpected.error()), mHasValue(false) {}
+
+		[[nodiscard]] bool has_value() const noexcept { return mHasValue; }
+		explicit operator bool() const noexcept { return mHasValue; }
+
+		void value() const noexcept { SOCKLIB_ASSERT(mHasValue, "Result holds an error!"); }
+
+		[[nodiscard]] const std::error_code& error() const noexcept { return mError; }
+
+	private:
+
+		std::error_code mError;
+		bool mHasValue = true;
+
+	};
+#endif
+
+	/**
+	* @brief Checks whether a failed call only has to be retried later
+	* @details True for EAGAIN/EWOULDBLOCK (nothing to transfer yet or a timeout expired),
+	*	EINPROGRESS/EALREADY (a non-blocking connect is on its way) and WSAETIMEDOUT which
+	*	is how Windows reports an expired SO_RCVTIMEO/SO_SNDTIMEO.
+	*	Unix ETIMEDOUT is not included: there it means the connection is dead (keepalive or
+	*	retransmissions gave up) or that a TryConnect deadline passed, so retrying won't help.
+	*	The classic methods that return -1 instead of a Result still treat it as a timeout.
+	*	EINTR never reaches callers, interrupted calls are restarted internally.
+	* @param error The error code of the failed call
+	* @return True if the socket is fine and the call can be repeated
+	*/
+	inline bool WouldBlock(const std::error_code& error) noexcept
+	{
+		if (error.category() != std::system_category()) return false;
+		switch (error.value())
+		{
+#ifdef PLATFORM_WINDOWS
+		case WSAEWOULDBLOCK:
+		case WSAEINPROGRESS:
+		case WSAEALREADY:
+		case WSAETIMEDOUT:
+#else
+		case EAGAIN:
+	#if EWOULDBLOCK != EAGAIN
+		case EWOULDBLOCK:
+	#endif
+		case EINPROGRESS:
+		case EALREADY:
+#endif
+			return true;
+		default:
+			return false;
+		}
+	}
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <socklib/Socket.h>
+#include <span>
+
+namespace socklib {
+
+	/**
+	* @brief A byte ring buffer whose readable and writable regions are always contiguous
+	* @details The same memory is mapped twice, back to back, so reading or writing past the end
+	*	of the first mapping continues at the start of the buffer. Parsers can therefore look at
+	*	a frame that wraps around as one contiguous span instead of copying it, and Receive() can
+	*	fill all the free space with a single system call. The memory comes from memfd_create on
+	*	Linux, an unlinked shm_open object on the rest of the Unix-Like systems and a page file
+	*	backed section on Windows.
+	*	The capacity is rounded up to the page size (the allocation granularity on Windows).
+	*/
+	class RingBuffer {
+	public:
+
+		//Constructor(s) & Destructor
+		RingBuffer() noexcept = default;
+		RingBuffer(const RingBuffer&) = delete;
+
+		/**
+		* @brief Maps a ring buffer
+		* @param capacity Minimum number of bytes the buffer can hold
+		*/
+		explicit RingBuffer(size_t capacity) noexcept;
+
+		RingBuffer(RingBuffer&& other) noexcept;
+
+		~RingBuffer() noexcept;
+
+		/**
+		* @brief Checks whether the memory was mapped successfully
+		*/
+		[[nodiscard]] bool IsValid() const noexcept { return mData != nullptr; }
+
+		/**
+		* @brief Getter for the number of bytes the buffer can hold
+		*/
+		[[nodiscard]] size_t Capacity() const noexcept { return mCapacity; }
+
+		/**
+		* @brief Getter for the number of bytes that are ready to be read
+		*/
+		[[nodiscard]] size_t Size() const noexcept { return mSize; }
+
+		/**
+		* @brief Getter for the number of bytes that can be written
+		*/
+		[[nodiscard]] size_t Free() const noexcept { return mCapacity - mSize; }
+
+		[[nodiscard]] bool Empty() const noexcept { return mSize == 0; }
+
+		[[nodiscard]] bool Full() const noexcept { return mSize == mCapacity; }
+
+		/**
+		* @brief Contiguous view of the bytes that are ready to be read
+		* @details Stays valid until Consume() or Clear() is called
+		*/
+		[[nodiscard]] std::span<BYTE> Readable() const noexcept { return { mData + mRead, mSize }; }
+
+		/**
+		* @brief Contiguous view of the free space
+		* @details Write into it and then Commit() how many bytes were written
+		*/
+		[[nodiscard]] std::span<BYTE> Writable() const noexcept { return { mData + mRead + mSize, mCapacity - mSize }; }
+
+		/**
+		* @brief Makes bytes that were written into Writable() readable
+		* @param bytes Number of bytes that were written
+		*/
+		void Commit(size_t bytes) noexcept;
+
+		/**
+		* @brief Discards bytes from the start of Readable()
+		* @param bytes Number of bytes that were read
+		*/
+		void Consume(size_t bytes) noexcept;
+
+		/**
+		* @brief Discards every readable byte
+		*/
+		void Clear() noexcept { mRead = 0; mSize = 0; }
+
+		/**
+		* @brief Copies data into the free space
+		* @param data Pointer to the data that will be written
+		* @param length Number of bytes that will be written
+		* @return The number of bytes that were written, less than length if the buffer got full
+		*/
+		size_t Write(const void* data, size_t length) noexcept;
+
+		/**
+		* @brief Copies readable bytes out and consumes them
+		* @param[out] data Pointer to the buffer that receives the bytes
+		* @param length Maximum number of bytes that will be read
+		* @return The number of bytes that were read
+		*/
+		size_t Read(void* data, size_t length) noexcept;
+
+		/**
+		* @brief Receives from a connected socket straight into the free space
+		* @param sock The socket to receive from
+		* @return The number of bytes that were received (0 if the peer shut down or there is no
+		*	free space), or the error code of the failure
+		*/
+		Result<size_t> Receive(const Socket& sock) noexcept;
+
+		RingBuffer& operator=(const RingBuffer&) = delete;
+
+		RingBuffer& operator=(RingBuffer&& rhs) noexcept;
+
+	private:
+
+		void Unmap() noexcept;
+
+	private:
+
+		BYTE* mData = nullptr;
+
+		size_t mCapacity = 0;
+
+		//Offset of the first readable byte, always less than mCapacity
+		size_t mRead = 0;
+
+		size_t mSize = 0;
+
+	};
+
+}
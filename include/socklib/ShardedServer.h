@@ -0,0 +1,141 @@
+#pragma once
+
+#include <socklib/Poller.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace socklib {
+
+	/**
+	* @brief Settings of a ShardedServer
+	*/
+	struct ShardedServerOptions {
+		/**
+		* @brief Number of listeners/worker threads, 0 means one per hardware thread
+		*/
+		size_t Shards = 0;
+		/**
+		* @brief Pins the worker of shard i to the i-th CPU the process may run on (modulo their number)
+		*/
+		bool PinThreads = true;
+		/**
+		* @brief Attaches a classic BPF program that steers each connection to the shard of the CPU
+		*	that received it, so the connection stays on the core whose cache is already warm
+		* @details Only supported on Linux, when it is unavailable the kernel hash is used instead. The
+		*	k-th CPU of the affinity mask (as it is when the server is created) is steered to shard
+		*	k % Shards, the one PinThreads puts on it.
+		*/
+		bool SteerByCpu = false;
+		/**
+		* @brief Parameter that will be pass to Listen function of every listener
+		*/
+		int Queue = SOMAXCONN;
+	};
+
+	/**
+	* @brief A TCP server that accepts connections on many threads at once
+	* @details Opens one listener per shard on the same endpoint with SO_REUSEPORT, so the kernel
+	*	keeps a separate accept queue for each of them, and serves every listener from its own
+	*	worker thread with its own Poller. The accept rate therefore scales with the cores instead
+	*	of being bottlenecked on a single queue and thread.
+	*	Accepted connections are handed to the handler on the thread of the shard that accepted
+	*	them, together with the Poller of that thread, so all their I/O stays on that core.
+	*	On platforms without SO_REUSEPORT all the workers share a single listener.
+	*	When accepting fails for a reason other than an empty backlog (EMFILE, ENFILE, ENOBUFS...)
+	*	the shard stops watching its listener for a short while instead of spinning on it.
+	*/
+	class ShardedServer {
+	public:
+
+		/**
+		* @brief Callback that is invoked on the worker thread with its Poller, the accepted
+		*	non-blocking connection and the address of the peer
+		*/
+		using Handler = std::function<void(Poller&, Socket, const SocketAddress&)>;
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Opens, binds and starts listening on every shard
+		* @param family Address family for the listeners
+		* @param endpoint Pair of IP and port number that the listeners will be bound to
+		* @param handler Callback that takes ownership of the accepted connections
+		* @param options Number of shards, thread pinning and steering settings
+		*/
+		ShardedServer(AddressFamily family, const Endpoint& endpoint, Handler handler, const ShardedServerOptions& options = {}) noexcept;
+		ShardedServer(const ShardedServer&) = delete;
+		~ShardedServer() noexcept;
+
+		/**
+		* @brief Spawns the worker threads
+		*/
+		void Start() noexcept;
+
+		/**
+		* @brief Stops the event loops and joins the worker threads
+		* @details Connections that are still registered on the Pollers are left untouched
+		*/
+		void Stop() noexcept;
+
+		/**
+		* @brief Getter for the number of shards
+		*/
+		[[nodiscard]] size_t Shards() const noexcept { return mShards.size(); }
+
+		/**
+		* @brief Getter for the number of connections a shard has accepted so far
+		* @param shard Index of the shard
+		*/
+		[[nodiscard]] uint64_t Accepted(size_t shard) const noexcept;
+
+		/**
+		* @brief Getter for the number of times a shard failed to accept and backed off
+		* @param shard Index of the shard
+		*/
+		[[nodiscard]] uint64_t AcceptFailures(size_t shard) const noexcept;
+
+		/**
+		* @brief Checks whether the CPU steering program is attached
+		*/
+		[[nodiscard]] bool IsSteered() const noexcept { return mSteered; }
+
+		ShardedServer& operator=(const ShardedServer&) = delete;
+
+	private:
+
+		//Connections taken from the backlog with a single AcceptMany
+		static constexpr size_t ACCEPT_BATCH = 64;
+
+		//How long a shard ignores its listener after a failed accept
+		static constexpr std::chrono::milliseconds ACCEPT_BACKOFF{ 50 };
+
+		struct Shard {
+			Socket Listener;
+			Poller Loop;
+			std::thread Worker;
+			std::atomic<bool> Stopping = false;
+			std::atomic<uint64_t> Accepted = 0;
+			std::atomic<uint64_t> Failures = 0;
+			socklib::Accepted Batch[ACCEPT_BATCH];
+		};
+
+		void Serve(Shard& shard) const noexcept;
+
+		bool AttachSteering() const noexcept;
+
+	private:
+
+		std::vector<std::unique_ptr<Shard>> mShards;
+
+		Handler mHandler;
+
+		bool mPinThreads;
+
+		bool mSteered = false;
+
+	};
+
+}
@@ -1,11 +1,22 @@
 #pragma once
 
 #include <socklib/Platform.h>
+#include <socklib/Result.h>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 
 namespace socklib {
 
+	class Poller;
+	class AcceptAwaitable;
+	class ConnectAwaitable;
+	class ReceiveAwaitable;
+	class SendAwaitable;
+	struct Accepted;
+
 	/**
 	* @brief Kilo Byte
 	*/
@@ -19,64 +30,808 @@ namespace socklib {
 	*/
 	constexpr size_t GiB = 1024 * MiB;
 
-	typedef unsigned char BYTE;
+	typedef unsigned char BYTE;
+
+	enum class AddressFamily : int {
+		UNSPECIFIED = AF_UNSPEC, // Not supported
+		UNIX = AF_UNIX, // Not supported
+		IPv4 = AF_INET,
+		IPv6 = AF_INET6,
+		// BLUETOOTH = AF_BLUETOOTH, // Not supported yet
+	};
+
+	enum class SocketType : int {
+		UNSPECIFIED = 0,
+		STREAM = SOCK_STREAM,
+		DGRAM = SOCK_DGRAM,
+		RAW = SOCK_RAW, // Not supported
+		RDM = SOCK_RDM, // Not supported
+		SEQ_PACKET = SOCK_SEQPACKET, // Not supported
+		// DCCP = SOCK_DCCP, // Not supported
+		// PACKET = SOCK_PACKET, // Not supported
+		// CLOEXEC = SOCK_CLOEXEC, // Not supported
+		// NONBLOCK = SOCK_NONBLOCK // Not supported
+	};
+
+	/**
+	 * @brief Basically a pair of IP and port
+	 * @details This structure is meant to be used as syntax sugar
+	 * 	for some of the Socket methods such as SendTo
+	 */
+	struct Endpoint {
+		/**
+		 * @brief Host's IP Address
+		 */
+		std::string Host = "0.0.0.0";
+		/**
+		 * @brief Port number
+		 */
+		unsigned short Port = 0;
+		//Constructor(s)
+		Endpoint() = default;
+		Endpoint(const std::string& host, const unsigned short port)
+			: Host(host), Port(port) {}
+		Endpoint(std::string&& host, const unsigned short port)
+			: Host(std::move(host)), Port(port) {}
+		Endpoint(const char* host, const unsigned short port)
+			: Host(host), Port(port) {}
+
+	};
+
+	/**
+	 * @brief Settings applied while a socket is opened
+	 * @details Flags the platform accepts at creation (SOCK_NONBLOCK and SOCK_CLOEXEC on Linux) go
+	 * 	straight into socket(), the rest costs one setsockopt each and is only issued when it
+	 * 	differs from the system default. The defaults open the same socket Open always did.
+	 */
+	struct SocketOptions {
+		/**
+		 * @brief Opens the socket in non-blocking mode
+		 */
+		bool NonBlocking = false;
+		/**
+		 * @brief Keeps the socket from being inherited by child processes
+		 */
+		bool CloseOnExec = false;
+		/**
+		 * @brief Sets SO_REUSEADDR, so a server can bind again while old connections are in TIME_WAIT
+		 */
+		bool ReuseAddress = true;
+		/**
+		 * @brief Sets SO_REUSEPORT, a no-op on platforms that don't support it (Windows)
+		 * @sa UniqueSocket::SetReusePort
+		 */
+		bool ReusePort = false;
+		/**
+		 * @brief Sets TCP_NODELAY, only applies to stream sockets
+		 */
+		bool NoDelay = false;
+		/**
+		 * @brief Sets SO_KEEPALIVE
+		 */
+		bool KeepAlive = false;
+		/**
+		 * @brief Bytes of SO_SNDBUF, 0 keeps the system default
+		 */
+		int SendBuffer = 0;
+		/**
+		 * @brief Bytes of SO_RCVBUF, 0 keeps the system default
+		 */
+		int ReceiveBuffer = 0;
+		/**
+		 * @brief Seconds of SO_LINGER, 0 resets the connection on close and a negative value keeps
+		 * 	the default graceful close
+		 */
+		int Linger = -1;
+		/**
+		 * @brief SO_PRIORITY of the outgoing packets, negative keeps the default. Only Linux supports it
+		 */
+		int Priority = -1;
+	};
+
+	/**
+	 * @brief A binary IPv4/IPv6 address and port
+	 * @details Wraps a sockaddr_storage, so it is handed over to the kernel as it is. Unlike
+	 * 	Endpoint it never allocates: comparison and hashing work on the binary form and the
+	 * 	text form is only produced when ToString(), Host() or ToEndpoint() is called
+	 */
+	class SocketAddress {
+	public:
+
+		//Constructor(s)
+		SocketAddress() noexcept = default;
+
+		/**
+		 * @brief Copies a native socket address
+		 * @param address Pointer to the native address (Basically a pair of address and port number)
+		 * @param size Size in bytes of the address structure
+		 */
+		SocketAddress(const sockaddr* address, socklen_t size) noexcept;
+
+		/**
+		 * @brief Parses an IPv4 or IPv6 address in its text form
+		 * @param host Host's IP Address, the address family is detected from it
+		 * @param port Port number
+		 * @return The parsed address, or an invalid (UNSPECIFIED family) address if host isn't an IP
+		 */
+		[[nodiscard]] static SocketAddress Parse(const char* host, unsigned short port) noexcept;
+
+		/**
+		 * @brief Parses an Endpoint
+		 * @param endpoint A pair of IP and port
+		 * @return The parsed address, or an invalid (UNSPECIFIED family) address if Host isn't an IP
+		 */
+		[[nodiscard]] static SocketAddress Parse(const Endpoint& endpoint) noexcept { return Parse(endpoint.Host.c_str(), endpoint.Port); }
+
+		/**
+		 * @brief The wildcard address of a family
+		 * @param family Either IPv4 or IPv6
+		 * @param port Port number
+		 * @return 0.0.0.0 or :: with the given port
+		 */
+		[[nodiscard]] static SocketAddress Any(AddressFamily family, unsigned short port) noexcept;
+
+		/**
+		 * @brief Getter for the address family
+		 * @return The address family, UNSPECIFIED for a default constructed address
+		 */
+		[[nodiscard]] AddressFamily Family() const noexcept { return static_cast<AddressFamily>(mStorage.ss_family); }
+
+		/**
+		 * @brief Getter for the port number
+		 * @return The port number in host byte order
+		 */
+		[[nodiscard]] unsigned short Port() const noexcept;
+
+		/**
+		 * @brief Checks whether this is an IPv4 or IPv6 address
+		 */
+		[[nodiscard]] bool IsValid() const noexcept { return Family() == AddressFamily::IPv4 || Family() == AddressFamily::IPv6; }
+
+		/**
+		 * @brief Getter for the native address
+		 * @return Pointer to the address, suitable for the sockaddr based methods
+		 */
+		[[nodiscard]] const sockaddr* Data() const noexcept { return reinterpret_cast<const sockaddr*>(&mStorage); }
+
+		/**
+		 * @brief Getter for the native address, to let the kernel fill it
+		 * @return Pointer to the address, Resize() must be called with the resulting size
+		 */
+		[[nodiscard]] sockaddr* Data() noexcept { return reinterpret_cast<sockaddr*>(&mStorage); }
+
+		/**
+		 * @brief Getter for the size of the native address
+		 * @return Size in bytes of the address structure
+		 */
+		[[nodiscard]] socklen_t Size() const noexcept { return mSize; }
+
+		/**
+		 * @brief Setter for the size of the native address, after it was filled by the kernel
+		 * @param size Size in bytes of the address structure
+		 */
+		void Resize(const socklen_t size) noexcept { mSize = size; }
+
+		/**
+		 * @brief Maximum size of a native address
+		 */
+		static constexpr socklen_t Capacity() noexcept { return sizeof(sockaddr_storage); }
+
+		/**
+		 * @brief Formats the IP address
+		 * @return The IP address in its text form, without the port
+		 */
+		[[nodiscard]] std::string Host() const;
+
+		/**
+		 * @brief Formats the address
+		 * @return "ip:port" for IPv4 and "[ip]:port" for IPv6
+		 */
+		[[nodiscard]] std::string ToString() const;
+
+		/**
+		 * @brief Converts to the text based representation
+		 * @return A pair of IP and port
+		 */
+		[[nodiscard]] Endpoint ToEndpoint() const { return { Host(), Port() }; }
+
+		/**
+		 * @brief Hashes the binary form of the address
+		 * @return A hash of the family, IP address and port
+		 */
+		[[nodiscard]] size_t Hash() const noexcept;
+
+		/**
+		 * @brief Compares family, IP address and port (and scope for IPv6)
+		 */
+		bool operator==(const SocketAddress& rhs) const noexcept;
+
+	private:
+
+		sockaddr_storage mStorage = {};
+		socklen_t mSize = 0;
+
+	};
+
+	/**
+	 * @brief A buffer (pointer and length pair) for vectored I/O
+	 * @details The layout matches the platform's native type (iovec or WSABUF), so arrays
+	 * 	of IOBuffer are handed over to the kernel as they are
+	 */
+	struct IOBuffer {
+#ifdef PLATFORM_WINDOWS
+		ULONG Length = 0;
+		char* Data = nullptr;
+		//Constructor(s)
+		IOBuffer() = default;
+		IOBuffer(const void* data, const size_t length)
+			: Length(static_cast<ULONG>(length)), Data(static_cast<char*>(const_cast<void*>(data))) {}
+#else
+		void* Data = nullptr;
+		size_t Length = 0;
+		//Constructor(s)
+		IOBuffer() = default;
+		IOBuffer(const void* data, const size_t length)
+			: Data(const_cast<void*>(data)), Length(length) {}
+#endif
+	};
+
+	/**
+	 * @brief A single datagram for batched I/O
+	 * @details Used by Socket::ReceiveBatch and Socket::SendBatch, addresses are kept in their
+	 * 	binary form so no text conversion is involved. The memory always belongs to the caller,
+	 * 	the batch calls never allocate; a BufferPool buffer sliced into datagrams works well.
+	 */
+	struct Datagram {
+		/**
+		 * @brief Pointer to the datagram's buffer
+		 */
+		void* Data = nullptr;
+		/**
+		 * @brief Size of the buffer when receiving, number of bytes to send when sending
+		 */
+		size_t Length = 0;
+		/**
+		 * @brief Number of bytes that were actually transferred
+		 */
+		size_t Bytes = 0;
+		/**
+		 * @brief Source address when receiving, destination address when sending
+		 */
+		SocketAddress Address;
+	};
+
+	/**
+	* @brief A move-only owner of a native socket
+	* @details The lightweight counterpart of Socket: it stores nothing but the native file descriptor,
+	*	so it is exactly as big as a SOCKET, never allocates and involves no reference counting. That makes it
+	*	suitable for keeping huge numbers of connections in flat arrays. It is closed when it goes out of
+	*	scope. Shared ownership is an explicit opt-in by moving it into a Socket.
+	*	Since the address family isn't stored, only the sockaddr based overloads are offered.
+	* @sa Socket
+	*/
+	class UniqueSocket {
+	public:
+
+		//Constructor(s) & Destructor
+		UniqueSocket() noexcept = default;
+		UniqueSocket(const UniqueSocket&) = delete;
+		~UniqueSocket() noexcept;
+
+		/**
+		* @brief Takes ownership of a native socket
+		* @param sock The file descriptor of an already opened socket
+		*/
+		explicit UniqueSocket(const SOCKET sock) noexcept
+			: mSock(sock) {}
+
+		/**
+		* @brief Constructs a UniqueSocket object and calls Open
+		* @param family Address family for the socket
+		* @param type The socket's type
+		* @param proto The protocol to be used by the socket
+		* @param options Settings applied while the socket is opened
+		* @sa Open method
+		*/
+		UniqueSocket(const AddressFamily family, const SocketType type, const int proto = 0, const SocketOptions& options = {}) noexcept { Open(family, type, proto, options); }
+
+		/**
+		* @brief Move Constructor
+		* @param other An r-value of a UniqueSocket, that is left like a default constructed one
+		*/
+		UniqueSocket(UniqueSocket&& other) noexcept
+			: mSock(other.mSock) { other.mSock = INVALID_SOCKET; }
+
+		/**
+		* @brief Opens the socket
+		* @param family Address family for the socket
+		* @param type The socket's type
+		* @param proto The protocol to be used by the socket
+		* @param options Settings applied while the socket is opened
+		*/
+		void Open(AddressFamily family, SocketType type, int proto = 0, const SocketOptions& options = {}) noexcept;
+
+		/**
+		* @brief Binds the socket
+		* @param address Pointer to the address that you want to bound (Basically a pair of address and port number)
+		* @param size Size in bytes of the address structure
+		*/
+		void Bind(const sockaddr* address, socklen_t size) const noexcept;
+
+		/**
+		* @brief Binds the socket
+		* @param address The address that you want to bound
+		*/
+		void Bind(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Disables sends or receives on a socket
+		* @param how Specification for what should be disabled (reception, transmission, or both)
+		*/
+		void Shutdown(int how) const noexcept;
+
+		/**
+		* @brief Closes an already open socket
+		*/
+		void Close() noexcept;
+
+		/**
+		* @brief Establish connection with another socket
+		* @param address Pointer to socket address of the remote host process (Basically a pair of address and port number)
+		* @param size Size in bytes of the address structure
+		*/
+		void Connect(const sockaddr* address, socklen_t size) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket
+		* @param address Socket address of the remote host process
+		*/
+		void Connect(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Places the socket in a state in which it is listening for an incoming connection
+		* @param length The maximum size of the queue of pending connections
+		*/
+		void Listen(int length = SOMAXCONN) const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @param[out] address Pointer that hold the address of the new client (Basically a pair of address and port number)
+		* @param[out] size Pointer that hold the size of client's address
+		* @return The new connection, or a closed UniqueSocket on timeout
+		*/
+		[[nodiscard]] UniqueSocket Accept(sockaddr* address = nullptr, socklen_t* size = nullptr) const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @param[out] address The address of the new client, no text conversion is involved
+		* @return The new connection, or a closed UniqueSocket on timeout
+		*/
+		[[nodiscard]] UniqueSocket Accept(SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Sends data to the connected socket
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send
+		*/
+		IOSize Send(const void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data to the specified address
+		* @param data Pointer to the data buffer that will be sent
+		* @param address Pointer to socket address of the remote host process (Basically a pair of address and port number)
+		* @param addressSize Size in bytes of the address structure
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendTo(const void* data, const sockaddr* address, socklen_t addressSize, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data to the specified address
+		* @param data Pointer to the data buffer that will be sent
+		* @param address Socket address of the remote host process
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendTo(const void* data, const SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the connected socket with a single system call
+		* @param buffers The buffers that will be sent, in order
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the specified address with a single system call
+		* @param buffers The buffers that will be sent, in order (as a single datagram)
+		* @param address Pointer to socket address of the remote host process (Basically a pair of address and port number)
+		* @param addressSize Size in bytes of the address structure
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendToV(std::span<const IOBuffer> buffers, const sockaddr* address, socklen_t addressSize) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket
+		* @param[out] data Pointer to the data that will be received
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received
+		*/
+		IOSize Receive(void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data
+		* @param[out] data Pointer to the data that will be received
+		* @param[out] address Pointer that hold the address of the new client (Basically a pair of address and port number)
+		* @param[out] addressSize Pointer that hold the size of client's address
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveFrom(void* data, sockaddr* address, socklen_t* addressSize, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data
+		* @param[out] data Pointer to the data that will be received
+		* @param[out] address The address of the remote host, no text conversion is involved
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveFrom(void* data, SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Receives data into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @param[out] address Pointer that hold the address of the remote host (Basically a pair of address and port number)
+		* @param[in,out] addressSize Pointer that hold the size of remote host's address
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveFromV(std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize) const noexcept;
+
+		/**
+		* @brief Receives many datagrams at once
+		* @details On Linux this is a single recvmmsg() call (for up to 64 datagrams) that waits for the first
+		*	datagram only, on other platforms it falls back to receiving a single datagram.
+		* @param[in,out] datagrams Buffers to fill, on return Bytes and Address of the received ones are set
+		* @return The number of datagrams that were received or -1 on timeout
+		*/
+		IOSize ReceiveBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends many datagrams at once
+		* @details On Linux this is a single sendmmsg() call (for up to 64 datagrams), on other
+		*	platforms it falls back to one sendto() per datagram.
+		* @param[in,out] datagrams Datagrams to send, on return Bytes of the sent ones is set
+		* @return The number of datagrams that were sent or -1 on timeout
+		*/
+		IOSize SendBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends part of a file to the connected socket without copying it through user memory
+		* @details On Linux this is sendfile(), on other platforms it falls back to reading chunks of
+		*	the file and sending them. The file offset of fd is not modified (except on Windows).
+		*	Blocking sockets send the whole range unless the end of the file is reached first,
+		*	non-blocking ones send as much as fits and the call has to be repeated for the rest.
+		* @param fd Native file descriptor of a file opened for reading
+		* @param offset Position in the file of the first byte that will be sent
+		* @param count Number of bytes that will be sent
+		* @return The number of bytes that were actually send or -1 if nothing could be sent without blocking
+		*/
+		IOSize SendFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket straight into a file
+		* @details On Linux the data is moved with splice() through a pipe, so it never touches user
+		*	memory, on other platforms it falls back to receiving chunks and writing them. The file
+		*	offset of fd is not modified (except on Windows).
+		*	Blocking sockets receive until count bytes have been written or the peer shuts down,
+		*	non-blocking ones stop once no more data is available.
+		* @param fd Native file descriptor of a file opened for writing
+		* @param offset Position in the file where the first received byte will be written
+		* @param count Maximum number of bytes that will be received
+		* @return The number of bytes that were actually received (0 if the peer shut down) or -1 if nothing could be received without blocking
+		*/
+		IOSize ReceiveToFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		// The Try* variants below report every failure as an std::error_code instead of asserting, so
+		//	they are safe to use in release builds and in hot loops: no allocation and no extra errno
+		//	reads are involved. Use WouldBlock() to tell EAGAIN/EWOULDBLOCK/EINPROGRESS apart from
+		//	real failures, interrupted calls (EINTR) are restarted internally.
+
+		/**
+		* @brief Binds the socket
+		* @param address The address that you want to bound
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryBind(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Disables sends or receives on a socket
+		* @param how Specification for what should be disabled (reception, transmission, or both)
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryShutdown(int how) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket
+		* @param address Socket address of the remote host process
+		* @return Nothing, or the error code of the failure (EINPROGRESS for non-blocking sockets)
+		*/
+		Result<void> TryConnect(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket, giving up once the deadline passes
+		* @details The connect is issued in non-blocking mode and awaited with poll, so unlike
+		*	SO_SNDTIMEO nothing lingers on the socket afterwards. The mode is restored on return.
+		* @param address Socket address of the remote host process
+		* @param timeout Milliseconds the connect may take, 0 means no limit
+		* @param blocking Whether the socket is in blocking mode, which is what it is left in
+		* @return Nothing, or the error code of the failure (ETIMEDOUT if the time ran out). The
+		*	socket can't be connected again after a failure.
+		*/
+		Result<void> TryConnect(const SocketAddress& address, uint32_t timeout, bool blocking = true) const noexcept;
+
+		/**
+		* @brief Connects to the candidates in parallel, keeping the first connection that succeeds
+		* @details A TCP socket is opened per candidate and all of them connect at once, so a slow
+		*	or unreachable candidate doesn't hold up the others. The losing attempts are closed.
+		* @param candidates Socket addresses of the remote host process, IPv4 and IPv6 can be mixed
+		* @param timeout Milliseconds the attempts may take, 0 means no limit
+		* @param stagger Milliseconds between the starts of consecutive attempts, in the order of the
+		*	candidates, 0 starts them all at once. An attempt that fails starts the next one right away.
+		* @return The connected blocking socket and the index of its candidate, or the error code of
+		*	the last failure (ETIMEDOUT if the time ran out)
+		*/
+		[[nodiscard]] static Result<std::pair<UniqueSocket, size_t>> TryConnectFirst(std::span<const SocketAddress> candidates, uint32_t timeout = 0, uint32_t stagger = 0) noexcept;
+
+		/**
+		* @brief Places the socket in a state in which it is listening for an incoming connection
+		* @param length The maximum size of the queue of pending connections
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryListen(int length = SOMAXCONN) const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @return The new connection, or the error code of the failure
+		*/
+		[[nodiscard]] Result<UniqueSocket> TryAccept() const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @param[out] address The address of the new client
+		* @return The new connection, or the error code of the failure
+		*/
+		[[nodiscard]] Result<UniqueSocket> TryAccept(SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Accepts the pending connections until the backlog is empty or the span is full
+		* @details Every connection costs a single system call (accept4 on Linux) and no allocation: the
+		*	new sockets are already non-blocking and close-on-exec, and the peers are kept in binary form.
+		*	Meant for non-blocking listeners, a blocking one only returns once the span is full. Accept and
+		*	TryAccept still go through plain accept, their sockets are blocking and inheritable.
+		* @param[out] connections Filled with the new connections in order, sockets left in the entries
+		*	are closed when they are overwritten
+		* @return The number of connections that were accepted, or the error code of the failure (a
+		*	backlog that was empty already gives an error for which WouldBlock() is true)
+		*/
+		[[nodiscard]] Result<size_t> AcceptMany(std::span<Accepted> connections) const noexcept;
+
+		/**
+		* @brief Sends data to the connected socket
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySend(const void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data to the specified address
+		* @param data Pointer to the data buffer that will be sent
+		* @param address Socket address of the remote host process
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySendTo(const void* data, const SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket
+		* @param[out] data Pointer to the data that will be received
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceive(void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data
+		* @param[out] data Pointer to the data that will be received
+		* @param[out] address The address of the remote host
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceiveFrom(void* data, SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the connected socket with a single system call
+		* @param buffers The buffers that will be sent, in order
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySendV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceiveV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Sends all the data, however many system calls it takes
+		* @details With a timeout the socket is polled between the calls instead of blocking in them,
+		*	so the timeout bounds the whole transfer and non-blocking sockets work too
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out)
+		*/
+		Result<void> SendAll(const void* data, size_t length, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Sends all the data of many buffers, with as few vectored system calls as possible
+		* @details A partial send resumes from the first unsent byte, so headers in front of a large
+		*	payload are never sent twice and never have to be copied next to it
+		* @param[in,out] buffers The buffers that will be sent, in order. They are advanced past the sent
+		*	bytes, so after a failure they describe what is left
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out)
+		*/
+		Result<void> SendAllV(std::span<IOBuffer> buffers, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Receives exactly the given number of bytes, however many system calls it takes
+		* @param[out] data Pointer to the buffer that receives the data
+		* @param length Number of bytes that will be received
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out,
+		*	std::errc::no_message if the peer shut down first)
+		*/
+		Result<void> ReceiveExact(void* data, size_t length, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Fills every buffer completely, with as few vectored system calls as possible
+		* @param[in,out] buffers The buffers that will be filled, in order. They are advanced past the
+		*	received bytes, so after a failure they describe what is missing
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out,
+		*	std::errc::no_message if the peer shut down first)
+		*/
+		Result<void> ReceiveExactV(std::span<IOBuffer> buffers, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Receives many datagrams at once
+		* @param[in,out] datagrams Buffers to fill, on return Bytes and Address of the received ones are set
+		* @return The number of datagrams that were received, or the error code of the failure
+		* @sa ReceiveBatch
+		*/
+		Result<size_t> TryReceiveBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends many datagrams at once
+		* @param[in,out] datagrams Datagrams to send, on return Bytes of the sent ones is set
+		* @return The number of datagrams that were sent, or the error code of the failure
+		* @sa SendBatch
+		*/
+		Result<size_t> TrySendBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends part of a file to the connected socket without copying it through user memory
+		* @param fd Native file descriptor of a file opened for reading
+		* @param offset Position in the file of the first byte that will be sent
+		* @param count Number of bytes that will be sent
+		* @return The number of bytes that were actually send, or the error code of the failure
+		* @sa SendFile
+		*/
+		Result<size_t> TrySendFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket straight into a file
+		* @param fd Native file descriptor of a file opened for writing
+		* @param offset Position in the file where the first received byte will be written
+		* @param count Maximum number of bytes that will be received
+		* @return The number of bytes that were actually received, or the error code of the failure
+		* @sa ReceiveToFile
+		*/
+		Result<size_t> TryReceiveToFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		/**
+		* @brief Setter for blocking mode
+		* @param flag A bool false for non-blocking mode, true for blocking mode
+		*/
+		void SetBlocking(bool flag) const noexcept;
+
+		/**
+		* @brief Setter for socket's time out
+		* @param millis Milliseconds that the socket should wait before a timeout occurs
+		*/
+		void SetTimeout(uint32_t millis) const noexcept;
+
+		/**
+		* @brief Setter for SO_REUSEPORT
+		* @details Lets many sockets bind the same address so the kernel spreads incoming connections
+		*	(or datagrams) between them. It has to be set before Bind, and is a no-op on platforms
+		*	that don't support it (Windows).
+		* @param flag True to allow other sockets to bind the same address
+		*/
+		void SetReusePort(bool flag) const noexcept;
+
+		/**
+		* @brief Getter for Native File Descriptor
+		* @returns The file descriptor of the socket
+		*/
+		[[nodiscard]] SOCKET FileNo() const noexcept { return mSock; }
+
+		/**
+		* @brief Gives up ownership of the native socket without closing it
+		* @returns The file descriptor of the socket
+		*/
+		[[nodiscard]] SOCKET Release() noexcept;
 
-	enum class AddressFamily : int {
-		UNSPECIFIED = AF_UNSPEC, // Not supported
-		UNIX = AF_UNIX, // Not supported
-		IPv4 = AF_INET,
-		IPv6 = AF_INET6,
-		// BLUETOOTH = AF_BLUETOOTH, // Not supported yet
-	};
+		/**
+		* @brief Move assignment operation
+		* @details Close the current UniqueSocket if it is opened, and take over the other one
+		* @param rhs An r-value of a UniqueSocket, that is left like a default constructed one
+		*/
+		UniqueSocket& operator=(UniqueSocket&& rhs) noexcept;
+
+		UniqueSocket& operator=(const UniqueSocket&) = delete;
+
+	private:
+
+		SOCKET mSock = INVALID_SOCKET;
 
-	enum class SocketType : int {
-		UNSPECIFIED = 0,
-		STREAM = SOCK_STREAM,
-		DGRAM = SOCK_DGRAM,
-		RAW = SOCK_RAW, // Not supported
-		RDM = SOCK_RDM, // Not supported
-		SEQ_PACKET = SOCK_SEQPACKET, // Not supported
-		// DCCP = SOCK_DCCP, // Not supported
-		// PACKET = SOCK_PACKET, // Not supported
-		// CLOEXEC = SOCK_CLOEXEC, // Not supported
-		// NONBLOCK = SOCK_NONBLOCK // Not supported
 	};
 
 	/**
-	 * @brief Basically a pair of IP and port
-	 * @details This structure is meant to be used as syntax sugar
-	 * 	for some of the Socket methods such as SendTo
-	 */
-	struct Endpoint {
-		/**
-		 * @brief Host's IP Address
-		 */
-		std::string Host = "0.0.0.0";
-		/**
-		 * @brief Port number
-		 */
-		unsigned short Port = 0;
-		//Constructor(s)
-		Endpoint() = default;
-		Endpoint(const std::string& host, const unsigned short port)
-			: Host(host), Port(port) {}
-		Endpoint(std::string&& host, const unsigned short port)
-			: Host(std::move(host)), Port(port) {}
-		Endpoint(const char* host, const unsigned short port)
-			: Host(host), Port(port) {}
-
+	* @brief A connection taken by AcceptMany
+	*/
+	struct Accepted {
+		UniqueSocket Sock;
+		SocketAddress Peer;
 	};
 
 	/**
 	* @brief A platform-agnostic Socket object
 	* @details A python like socket object that also support low level functionality.
 	*	Object are automatically closed when all references are invalidated, but it is
-	*	recommended to Close() explicitly. The implementation basically is wrapper over
-	*	C-API platform specific calls, that uses share_ptr on the file descriptor of a socket
+	*	recommended to Close() explicitly. The implementation basically is a shared_ptr over
+	*	a UniqueSocket, use UniqueSocket directly when shared ownership is not needed.
+	* @sa UniqueSocket for how the Try* variants report failures
 	*/
 	class Socket {
 	public:
 
+		/**
+		* @brief Default stagger of TryConnectDualStack, the Connection Attempt Delay RFC 8305 recommends
+		*/
+		static constexpr uint32_t CONNECTION_ATTEMPT_DELAY = 250;
+
 		//Constructor(s) & Destructor
 		Socket() noexcept = default;
 		Socket(const Socket&) = default;
@@ -87,10 +842,11 @@ namespace socklib {
 		* @param family Address family for the socket
 		* @param type The socket's type
 		* @param proto The protocol to be used by the socket
+		* @param options Settings applied while the socket is opened
 		* @sa Open method
 		*/
-		Socket(const AddressFamily family, const SocketType type, const int proto = 0) noexcept
-			: Socket() { Open(family, type, proto); }
+		Socket(const AddressFamily family, const SocketType type, const int proto = 0, const SocketOptions& options = {}) noexcept
+			: Socket() { Open(family, type, proto, options); }
 
 		/**
 		* @brief Move Constructor
@@ -100,14 +856,23 @@ namespace socklib {
 		*/
 		Socket(Socket&& other) noexcept;
 
+		/**
+		* @brief Takes shared ownership of a UniqueSocket
+		* @param sock An r-value of a UniqueSocket, that is left like a default constructed one
+		* @param family Address family that the socket has been opened with
+		* @param blocking Whether the socket is in blocking mode, as IsBlocking() reports it
+		*/
+		Socket(UniqueSocket&& sock, AddressFamily family, bool blocking = true) noexcept;
+
 		/**
 		* @brief Opens the socket
 		* @details Opens the socket using the given address family, socket type and protocol number.
 		* @param family Address family for the socket
 		* @param type The socket's type
 		* @param proto The protocol to be used by the socket
+		* @param options Settings applied while the socket is opened, IsBlocking() follows NonBlocking
 		*/
-		void Open(AddressFamily family, SocketType type, int proto = 0) noexcept;
+		void Open(AddressFamily family, SocketType type, int proto = 0, const SocketOptions& options = {}) noexcept;
 
 		/**
 		* @brief Binds the socket
@@ -139,6 +904,12 @@ namespace socklib {
 		*/
 		void Bind(const sockaddr* address, socklen_t size) const noexcept;
 
+		/**
+		* @brief Binds the socket
+		* @param address The address that you want to bound
+		*/
+		void Bind(const SocketAddress& address) const noexcept;
+
 		/**
 		* @brief Disables sends or receives on a socket
 		* @param how Specification for what should be disabled (reception, transmission, or both)
@@ -180,6 +951,12 @@ namespace socklib {
 		*/
 		void Connect(const sockaddr* address, socklen_t size) const noexcept;
 
+		/**
+		* @brief Establish connection with another socket
+		* @param address Socket address of the remote host process
+		*/
+		void Connect(const SocketAddress& address) const noexcept;
+
 		/**
 		* @brief Places the socket in a state in which it is listening for an incoming connection
 		* @param length The maximum size of the queue of pending connections
@@ -200,6 +977,13 @@ namespace socklib {
 		*/
 		Socket Accept(sockaddr* address, socklen_t* size) const noexcept;
 
+		/**
+		* @brief Accepts a new connection
+		* @param[out] address The address of the new client, no text conversion is involved
+		* @return A Socket that can be used for sending and receiving data
+		*/
+		Socket Accept(SocketAddress& address) const noexcept;
+
 		/**
 		* @brief Sends data to the connected socket
 		* @param data Pointer to the data buffer that will be sent
@@ -231,6 +1015,16 @@ namespace socklib {
 		 * @sa Endpoint
 		 */
 		IOSize SendTo(const void* data, const Endpoint& endpoint, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data to the specified address
+		* @param data Pointer to the data buffer that will be sent
+		* @param address Socket address of the remote host process
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendTo(const void* data, const SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
 		
 		/**
 		* @brief Sends data from the connected socket
@@ -262,6 +1056,361 @@ namespace socklib {
 		*/
 		std::pair<IOSize, Endpoint> ReceiveFrom(void* data, size_t length, size_t offset = 0) const noexcept;
 
+		/**
+		* @brief Receives data
+		* @param[out] data Pointer to the data that will be received
+		* @param[out] address The address of the remote host, no text conversion is involved
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveFrom(void* data, SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the connected socket with a single system call
+		* @param buffers The buffers that will be sent, in order
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the specified address with a single system call
+		* @param buffers The buffers that will be sent, in order (as a single datagram)
+		* @param address Pointer to socket address of the remote host process (Basically a pair of address and port number)
+		* @param addressSize Size in bytes of the address structure
+		* @return The number of bytes that were actually send
+		*/
+		IOSize SendToV(std::span<const IOBuffer> buffers, const sockaddr* address, socklen_t addressSize) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Receives data into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @param[out] address Pointer that hold the address of the remote host (Basically a pair of address and port number)
+		* @param[in,out] addressSize Pointer that hold the size of remote host's address
+		* @return The number of bytes that were actually received
+		*/
+		IOSize ReceiveFromV(std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize) const noexcept;
+
+		/**
+		* @brief Receives many datagrams at once
+		* @details On Linux this is a single recvmmsg() call (for up to 64 datagrams) that waits for the first
+		*	datagram only, on other platforms it falls back to receiving a single datagram.
+		* @param[in,out] datagrams Buffers to fill, on return Bytes and Address of the received ones are set
+		* @return The number of datagrams that were received or -1 on timeout
+		*/
+		IOSize ReceiveBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends many datagrams at once
+		* @details On Linux this is a single sendmmsg() call (for up to 64 datagrams), on other
+		*	platforms it falls back to one sendto() per datagram.
+		* @param[in,out] datagrams Datagrams to send, on return Bytes of the sent ones is set
+		* @return The number of datagrams that were sent or -1 on timeout
+		*/
+		IOSize SendBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends part of a file to the connected socket without copying it through user memory
+		* @details On Linux this is sendfile(), on other platforms it falls back to reading chunks of
+		*	the file and sending them. The file offset of fd is not modified (except on Windows).
+		*	Blocking sockets send the whole range unless the end of the file is reached first,
+		*	non-blocking ones send as much as fits and the call has to be repeated for the rest.
+		* @param fd Native file descriptor of a file opened for reading
+		* @param offset Position in the file of the first byte that will be sent
+		* @param count Number of bytes that will be sent
+		* @return The number of bytes that were actually send or -1 if nothing could be sent without blocking
+		*/
+		IOSize SendFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket straight into a file
+		* @details On Linux the data is moved with splice() through a pipe, so it never touches user
+		*	memory, on other platforms it falls back to receiving chunks and writing them. The file
+		*	offset of fd is not modified (except on Windows).
+		*	Blocking sockets receive until count bytes have been written or the peer shuts down,
+		*	non-blocking ones stop once no more data is available.
+		* @param fd Native file descriptor of a file opened for writing
+		* @param offset Position in the file where the first received byte will be written
+		* @param count Maximum number of bytes that will be received
+		* @return The number of bytes that were actually received (0 if the peer shut down) or -1 if nothing could be received without blocking
+		*/
+		IOSize ReceiveToFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		// The Try* variants below report failures the same way UniqueSocket's do (see there)
+
+		/**
+		* @brief Binds the socket
+		* @param address The address that you want to bound
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryBind(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Disables sends or receives on a socket
+		* @param how Specification for what should be disabled (reception, transmission, or both)
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryShutdown(int how) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket
+		* @param address Socket address of the remote host process
+		* @return Nothing, or the error code of the failure (EINPROGRESS for non-blocking sockets)
+		*/
+		Result<void> TryConnect(const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket, giving up once the deadline passes
+		* @details The connect is issued in non-blocking mode and awaited with poll, so unlike
+		*	SO_SNDTIMEO nothing lingers on the socket afterwards
+		* @param address Socket address of the remote host process
+		* @param timeout Milliseconds the connect may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (ETIMEDOUT if the time ran out). The
+		*	socket can't be connected again after a failure.
+		*/
+		Result<void> TryConnect(const SocketAddress& address, uint32_t timeout) const noexcept;
+
+		/**
+		* @brief Connects to the candidates in parallel, keeping the first connection that succeeds
+		* @details A TCP socket is opened per candidate and all of them connect at once, so a slow
+		*	or unreachable candidate doesn't hold up the others. The losing attempts are closed.
+		* @param candidates Socket addresses of the remote host process, IPv4 and IPv6 can be mixed
+		* @param timeout Milliseconds the attempts may take, 0 means no limit
+		* @param[out] winner Set to the index of the candidate that was connected to, if not null
+		* @return The connected blocking socket, or the error code of the last failure (ETIMEDOUT if
+		*	the time ran out)
+		*/
+		[[nodiscard]] static Result<Socket> TryConnectFirst(std::span<const SocketAddress> candidates, uint32_t timeout = 0, size_t* winner = nullptr) noexcept;
+
+		/**
+		* @brief Connects to a dual-stack host the Happy Eyeballs way (RFC 8305)
+		* @details The addresses are interleaved by family starting with IPv6, and each attempt starts
+		*	once the previous one has been going for the stagger delay (or failed). The first connection
+		*	to complete is kept and the other attempts are closed, so a family that is blackholed only
+		*	costs the delay instead of a whole connect timeout.
+		* @param addresses Socket addresses of the remote host process, IPv4 and IPv6 in order of preference
+		* @param timeout Milliseconds the attempts may take, 0 means no limit
+		* @param stagger Milliseconds between the starts of consecutive attempts
+		* @param[out] winner Set to the index of the address that was connected to, if not null
+		* @return The connected blocking socket, or the error code of the last failure (ETIMEDOUT if
+		*	the time ran out)
+		*/
+		[[nodiscard]] static Result<Socket> TryConnectDualStack(std::span<const SocketAddress> addresses, uint32_t timeout = 0, uint32_t stagger = CONNECTION_ATTEMPT_DELAY, size_t* winner = nullptr) noexcept;
+
+		/**
+		* @brief Places the socket in a state in which it is listening for an incoming connection
+		* @param length The maximum size of the queue of pending connections
+		* @return Nothing, or the error code of the failure
+		*/
+		Result<void> TryListen(int length = SOMAXCONN) const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @return The new connection, or the error code of the failure
+		*/
+		[[nodiscard]] Result<Socket> TryAccept() const noexcept;
+
+		/**
+		* @brief Accepts a new connection
+		* @param[out] address The address of the new client
+		* @return The new connection, or the error code of the failure
+		*/
+		[[nodiscard]] Result<Socket> TryAccept(SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Accepts the pending connections until the backlog is empty or the span is full
+		* @details The connections are handed over as UniqueSockets, so none of them allocates until
+		*	it is wrapped in a Socket (with blocking set to false)
+		* @param[out] connections Filled with the new connections in order
+		* @return The number of connections that were accepted, or the error code of the failure
+		* @sa UniqueSocket::AcceptMany
+		*/
+		[[nodiscard]] Result<size_t> AcceptMany(std::span<Accepted> connections) const noexcept;
+
+		/**
+		* @brief Sends data to the connected socket
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySend(const void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data to the specified address
+		* @param data Pointer to the data buffer that will be sent
+		* @param address Socket address of the remote host process
+		* @param length Number of bytes that will be sent
+		* @param offset How many bytes away from the start should we start sending
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySendTo(const void* data, const SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket
+		* @param[out] data Pointer to the data that will be received
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceive(void* data, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Receives data
+		* @param[out] data Pointer to the data that will be received
+		* @param[out] address The address of the remote host
+		* @param[in] length Number of bytes that will be received
+		* @param[in] offset How many bytes away from the start should we start receiving
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceiveFrom(void* data, SocketAddress& address, size_t length, size_t offset = 0) const noexcept;
+
+		/**
+		* @brief Sends data from many buffers to the connected socket with a single system call
+		* @param buffers The buffers that will be sent, in order
+		* @return The number of bytes that were actually send, or the error code of the failure
+		*/
+		Result<size_t> TrySendV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket into many buffers with a single system call
+		* @param buffers The buffers that will be filled, in order
+		* @return The number of bytes that were actually received, or the error code of the failure
+		*/
+		Result<size_t> TryReceiveV(std::span<const IOBuffer> buffers) const noexcept;
+
+		/**
+		* @brief Sends all the data, however many system calls it takes
+		* @details With a timeout the socket is polled between the calls instead of blocking in them,
+		*	so the timeout bounds the whole transfer and non-blocking sockets work too
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out)
+		*/
+		Result<void> SendAll(const void* data, size_t length, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Sends all the data of many buffers, with as few vectored system calls as possible
+		* @details A partial send resumes from the first unsent byte, so headers in front of a large
+		*	payload are never sent twice and never have to be copied next to it
+		* @param[in,out] buffers The buffers that will be sent, in order. They are advanced past the sent
+		*	bytes, so after a failure they describe what is left
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out)
+		*/
+		Result<void> SendAllV(std::span<IOBuffer> buffers, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Receives exactly the given number of bytes, however many system calls it takes
+		* @param[out] data Pointer to the buffer that receives the data
+		* @param length Number of bytes that will be received
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out,
+		*	std::errc::no_message if the peer shut down first)
+		*/
+		Result<void> ReceiveExact(void* data, size_t length, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Fills every buffer completely, with as few vectored system calls as possible
+		* @param[in,out] buffers The buffers that will be filled, in order. They are advanced past the
+		*	received bytes, so after a failure they describe what is missing
+		* @param timeout Milliseconds the whole transfer may take, 0 means no limit
+		* @return Nothing, or the error code of the failure (WouldBlock() is true if the time ran out,
+		*	std::errc::no_message if the peer shut down first)
+		*/
+		Result<void> ReceiveExactV(std::span<IOBuffer> buffers, uint32_t timeout = 0) const noexcept;
+
+		/**
+		* @brief Receives many datagrams at once
+		* @param[in,out] datagrams Buffers to fill, on return Bytes and Address of the received ones are set
+		* @return The number of datagrams that were received, or the error code of the failure
+		* @sa ReceiveBatch
+		*/
+		Result<size_t> TryReceiveBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends many datagrams at once
+		* @param[in,out] datagrams Datagrams to send, on return Bytes of the sent ones is set
+		* @return The number of datagrams that were sent, or the error code of the failure
+		* @sa SendBatch
+		*/
+		Result<size_t> TrySendBatch(std::span<Datagram> datagrams) const noexcept;
+
+		/**
+		* @brief Sends part of a file to the connected socket without copying it through user memory
+		* @param fd Native file descriptor of a file opened for reading
+		* @param offset Position in the file of the first byte that will be sent
+		* @param count Number of bytes that will be sent
+		* @return The number of bytes that were actually send, or the error code of the failure
+		* @sa SendFile
+		*/
+		Result<size_t> TrySendFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket straight into a file
+		* @param fd Native file descriptor of a file opened for writing
+		* @param offset Position in the file where the first received byte will be written
+		* @param count Maximum number of bytes that will be received
+		* @return The number of bytes that were actually received, or the error code of the failure
+		* @sa ReceiveToFile
+		*/
+		Result<size_t> TryReceiveToFile(int fd, uint64_t offset, size_t count) const noexcept;
+
+		// The Async* methods below are awaited from a Task, they suspend the coroutine instead of
+		//	blocking and it is resumed from Poller::Poll() once the operation completes. Include
+		//	<socklib/Task.h> to use them. The socket must be in non-blocking mode and only a single
+		//	coroutine may await on it at a time.
+
+		/**
+		* @brief Accepts a new connection without blocking the thread
+		* @param poller The event loop that resumes the coroutine
+		* @return An awaitable of the new connection (already in non-blocking mode), or the error code of the failure
+		*/
+		[[nodiscard]] AcceptAwaitable AsyncAccept(Poller& poller) const noexcept;
+
+		/**
+		* @brief Accepts a new connection without blocking the thread
+		* @param poller The event loop that resumes the coroutine
+		* @param[out] address The address of the new client
+		* @return An awaitable of the new connection (already in non-blocking mode), or the error code of the failure
+		*/
+		[[nodiscard]] AcceptAwaitable AsyncAccept(Poller& poller, SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Establish connection with another socket without blocking the thread
+		* @param poller The event loop that resumes the coroutine
+		* @param address Socket address of the remote host process
+		* @return An awaitable of nothing, or the error code of the failure
+		*/
+		[[nodiscard]] ConnectAwaitable AsyncConnect(Poller& poller, const SocketAddress& address) const noexcept;
+
+		/**
+		* @brief Receives data from the connected socket without blocking the thread
+		* @param poller The event loop that resumes the coroutine
+		* @param[out] data Pointer to the data that will be received
+		* @param[in] length Number of bytes that will be received
+		* @return An awaitable of the number of bytes that were actually received (0 on end of stream), or the error code of the failure
+		*/
+		[[nodiscard]] ReceiveAwaitable AsyncReceive(Poller& poller, void* data, size_t length) const noexcept;
+
+		/**
+		* @brief Sends all the data to the connected socket without blocking the thread
+		* @details Unlike Send, the coroutine is only resumed once every byte has been sent (or on failure)
+		* @param poller The event loop that resumes the coroutine
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @return An awaitable of the number of bytes that were sent, or the error code of the failure
+		*/
+		[[nodiscard]] SendAwaitable AsyncSend(Poller& poller, const void* data, size_t length) const noexcept;
+
 		/**
 		* @brief Setter for blocking mode
 		* @param flag A bool false for non-blocking mode, true for blocking mode
@@ -274,6 +1423,15 @@ namespace socklib {
 		*/
 		void SetTimeout(uint32_t millis) const noexcept;
 
+		/**
+		* @brief Setter for SO_REUSEPORT
+		* @details Lets many sockets bind the same address so the kernel spreads incoming connections
+		*	(or datagrams) between them. It has to be set before Bind, and is a no-op on platforms
+		*	that don't support it (Windows).
+		* @param flag True to allow other sockets to bind the same address
+		*/
+		void SetReusePort(bool flag) const noexcept;
+
 		/**
 		* @brief Getter for Native File Descriptor
 		* @returns The file descriptor of the socket
@@ -298,26 +1456,57 @@ namespace socklib {
 		 * @brief Connects to a TCP service on the specified address
 		 * @param family Address family for the socket
 		 * @param endpoint Pair of IP and port number of their remote host that will attempt to connect
-		 * @param timeout Optional parameter to set a timeout option on the socket
+		 * @param timeout Optional milliseconds the connect may take, 0 means no limit. Only bounds the
+		 * 	connect, the socket is left without SO_SNDTIMEO/SO_RCVTIMEO
 		 * @param local Optional parameter to specify the local address that will be used by client
-		 * @return Socket after the requested connection has been established 
+		 * @return Socket after the requested connection has been established, or a closed socket if
+		 * 	the time ran out
 		 * @warning Only IPv4 and IPv6 are supported currently
 		 */
 		static Socket CreateConnection(AddressFamily family, const Endpoint& endpoint, uint32_t timeout = 0, const Endpoint& local = {}) noexcept;
 
+		/**
+		 * @brief Connects to a TCP service on the specified address, with a socket opened with options
+		 * @param family Address family for the socket
+		 * @param endpoint Pair of IP and port number of their remote host that will attempt to connect
+		 * @param options Settings applied while the socket is opened. A non-blocking socket may still
+		 * 	be connecting when it is returned, unless a timeout is given
+		 * @param timeout Optional milliseconds the connect may take, 0 means no limit
+		 * @param local Optional parameter to specify the local address that will be used by client
+		 * @return Socket after the requested connection has been established, or a closed socket if
+		 * 	the time ran out
+		 * @warning Only IPv4 and IPv6 are supported currently
+		 */
+		static Socket CreateConnection(AddressFamily family, const Endpoint& endpoint, const SocketOptions& options, uint32_t timeout = 0, const Endpoint& local = {}) noexcept;
+
 		/**
 		 * @brief Convenient function for creation a TCP server
 		 * @param family Address family for the socket
 		 * @param endpoint Pair of IP and port number of their remote host that will attempt to connect
 		 * @param queue Parameter that will be pass to Listen function
+		 * @param reusePort Sets SO_REUSEPORT before binding, so more servers can listen on the same endpoint
+		 * @return Socket ready to accept new client connections
+		 * @warning Only IPv4 and IPv6 are supported currently
+		 * @sa ShardedServer
+		 */
+		static Socket CreateServer(AddressFamily family, const Endpoint& endpoint, int queue = SOMAXCONN, bool reusePort = false) noexcept;
+
+		/**
+		 * @brief Convenient function for creation a TCP server, with a socket opened with options
+		 * @param family Address family for the socket
+		 * @param endpoint Pair of IP and port number of their remote host that will attempt to connect
+		 * @param options Settings applied while the socket is opened, before it is bound
+		 * @param queue Parameter that will be pass to Listen function
 		 * @return Socket ready to accept new client connections
 		 * @warning Only IPv4 and IPv6 are supported currently
 		 */
-		static Socket CreateServer(AddressFamily family, const Endpoint& endpoint, int queue = SOMAXCONN) noexcept;
+		static Socket CreateServer(AddressFamily family, const Endpoint& endpoint, const SocketOptions& options, int queue = SOMAXCONN) noexcept;
 
 	private:
 
-		std::shared_ptr<SOCKET> mSockRef;
+		friend class IOEngine;
+
+		std::shared_ptr<UniqueSocket> mSockRef;
 		
 		bool mBlockMode = true;
 
@@ -325,4 +1514,12 @@ namespace socklib {
 
 	};
 
-}
\ No newline at end of file
+}
+
+/**
+* @brief Lets SocketAddress be used as a key of unordered containers
+*/
+template<>
+struct std::hash<socklib::SocketAddress> {
+	size_t operator()(const socklib::SocketAddress& address) const noexcept { return address.Hash(); }
+};
\ No newline at end of file
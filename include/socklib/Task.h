@@ -0,0 +1,329 @@
+#pragma once
+
+#include <socklib/Poller.h>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace socklib {
+
+	template<typename T>
+	class Task;
+
+	/**
+	* @brief Promise state shared by every Task
+	* @details Tasks are lazy: they start when they are awaited, started or detached. Once a Task
+	*	finishes it resumes the coroutine that awaited it (symmetric transfer, so long chains of
+	*	Tasks don't grow the stack), or destroys itself if it was detached.
+	*/
+	class TaskPromiseBase {
+	public:
+
+		struct FinalAwaiter {
+			bool await_ready() const noexcept { return false; }
+
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+			{
+				TaskPromiseBase& promise = handle.promise();
+				if (promise.Detached)
+				{
+					handle.destroy();
+					return std::noop_coroutine();
+				}
+				return promise.Continuation ? promise.Continuation : std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+		void unhandled_exception() const noexcept { std::terminate(); }//socklib is built around noexcept
+
+		/**
+		* @brief The coroutine that is waiting for this one to finish
+		*/
+		std::coroutine_handle<> Continuation;
+		/**
+		* @brief True once the coroutine was resumed for the first time
+		*/
+		bool Started = false;
+		/**
+		* @brief True if nobody owns the coroutine, so it has to clean up after itself
+		*/
+		bool Detached = false;
+	};
+
+	template<typename T>
+	class TaskPromise : public TaskPromiseBase {
+	public:
+
+		Task<T> get_return_object() noexcept;
+
+		template<typename U>
+		void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) { Value.emplace(std::forward<U>(value)); }
+
+		std::optional<T> Value;
+	};
+
+	template<>
+	class TaskPromise<void> : public TaskPromiseBase {
+	public:
+
+		Task<void> get_return_object() noexcept;
+
+		void return_void() const noexcept {}
+	};
+
+	/**
+	* @brief A lazily started coroutine that produces a T
+	* @details A Task is awaited from another coroutine with co_await, or started from plain code
+	*	with Start() (keeping ownership) or Detach() (fire and forget). Together with the Async*
+	*	methods of Socket and a Poller, connection handlers are written as straight-line code
+	*	while a single thread serves any number of connections.
+	* @sa Socket::AsyncAccept, Socket::AsyncConnect, Socket::AsyncReceive, Socket::AsyncSend
+	*/
+	template<typename T = void>
+	class Task {
+	public:
+
+		using promise_type = TaskPromise<T>;
+		using Handle = std::coroutine_handle<promise_type>;
+
+		//Constructor(s) & Destructor
+		Task() noexcept = default;
+		Task(const Task&) = delete;
+
+		explicit Task(const Handle handle) noexcept
+			: mHandle(handle) {}
+
+		Task(Task&& other) noexcept
+			: mHandle(std::exchange(other.mHandle, {})) {}
+
+		~Task() noexcept
+		{
+			if (mHandle)
+				mHandle.destroy();
+		}
+
+		Task& operator=(const Task&) = delete;
+
+		Task& operator=(Task&& rhs) noexcept
+		{
+			if (this == &rhs) return *this;
+			if (mHandle)
+				mHandle.destroy();
+			mHandle = std::exchange(rhs.mHandle, {});
+			return *this;
+		}
+
+		/**
+		* @brief Runs the coroutine until its first suspension point
+		* @details Does nothing if it has already been started
+		*/
+		void Start() noexcept
+		{
+			SOCKLIB_ASSERT(mHandle, "The Task is empty!");
+			promise_type& promise = mHandle.promise();
+			if (promise.Started) return;
+			promise.Started = true;
+			mHandle.resume();
+		}
+
+		/**
+		* @brief Starts the coroutine (if needed) and gives up ownership of it
+		* @details The coroutine destroys itself when it finishes
+		*/
+		void Detach() noexcept
+		{
+			SOCKLIB_ASSERT(mHandle, "The Task is empty!");
+			const Handle handle = std::exchange(mHandle, {});
+			if (handle.done())
+			{
+				handle.destroy();
+				return;
+			}
+
+			promise_type& promise = handle.promise();
+			promise.Detached = true;
+			if (promise.Started) return;
+			promise.Started = true;
+			handle.resume();
+		}
+
+		/**
+		* @brief Checks whether the coroutine has finished
+		*/
+		[[nodiscard]] bool Done() const noexcept { return !mHandle || mHandle.done(); }
+
+		/**
+		* @brief Getter for the produced value
+		* @warning Only valid once the Task is Done()
+		*/
+		template<typename U = T> requires (!std::is_void_v<U>)
+		[[nodiscard]] U& Value() noexcept
+		{
+			SOCKLIB_ASSERT(mHandle && mHandle.done(), "The Task hasn't finished yet!");
+			return *mHandle.promise().Value;
+		}
+
+		bool await_ready() const noexcept { return Done(); }
+
+		std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+		{
+			promise_type& promise = mHandle.promise();
+			promise.Continuation = awaiting;
+			if (promise.Started) return std::noop_coroutine();//Already running, it'll resume us when it's done
+			promise.Started = true;
+			return mHandle;
+		}
+
+		T await_resume() noexcept
+		{
+			if constexpr (!std::is_void_v<T>)
+				return std::move(*mHandle.promise().Value);
+		}
+
+	private:
+
+		Handle mHandle;
+
+	};
+
+	template<typename T>
+	Task<T> TaskPromise<T>::get_return_object() noexcept { return Task<T>(Task<T>::Handle::from_promise(*this)); }
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept { return Task<void>(Task<void>::Handle::from_promise(*this)); }
+
+	/**
+	* @brief Base of the awaitables returned by the Async* methods of Socket
+	* @details The operation is attempted right away and the coroutine is only suspended if it
+	*	would block. In that case the socket is registered on the Poller and every readiness
+	*	notification attempts the operation again, once it completes (or fails) the socket is
+	*	unregistered and the coroutine is resumed from within Poller::Poll(). Destroying a Task
+	*	while it is suspended unregisters the socket as well.
+	*/
+	class IOAwaitable {
+	public:
+
+		IOAwaitable(const IOAwaitable&) = delete;
+		IOAwaitable& operator=(const IOAwaitable&) = delete;
+
+		bool await_ready() noexcept { return Attempt(); }
+
+		void await_suspend(std::coroutine_handle<> handle) noexcept;
+
+	protected:
+
+		IOAwaitable(Poller& poller, const Socket& sock, PollEvent interest) noexcept;
+		virtual ~IOAwaitable() noexcept;
+
+		/**
+		* @brief Performs the operation without blocking
+		* @return False if it would block, true once it has completed or failed
+		*/
+		virtual bool Attempt() noexcept = 0;
+
+		Poller& mPoller;
+		const Socket& mSock;
+
+	private:
+
+		void OnReady() noexcept;
+
+		PollEvent mInterest;
+		std::coroutine_handle<> mHandle;
+
+		//The descriptor while it is registered on the Poller, the socket itself might already be closed when we are destroyed
+		SOCKET mRegistered = INVALID_SOCKET;
+
+	};
+
+	/**
+	* @brief Awaitable of Socket::AsyncAccept
+	*/
+	class AcceptAwaitable : public IOAwaitable {
+	public:
+
+		AcceptAwaitable(Poller& poller, const Socket& sock, SocketAddress* address) noexcept
+			: IOAwaitable(poller, sock, PollEvent::READABLE), mAddress(address) {}
+
+		Result<Socket> await_resume() noexcept { return std::move(mResult); }
+
+	private:
+
+		bool Attempt() noexcept override;
+
+		SocketAddress* mAddress;
+		Result<Socket> mResult = Unexpected(std::error_code());
+
+	};
+
+	/**
+	* @brief Awaitable of Socket::AsyncConnect
+	*/
+	class ConnectAwaitable : public IOAwaitable {
+	public:
+
+		ConnectAwaitable(Poller& poller, const Socket& sock, const SocketAddress& address) noexcept
+			: IOAwaitable(poller, sock, PollEvent::WRITABLE), mAddress(address) {}
+
+		Result<void> await_resume() noexcept { return mResult; }
+
+	private:
+
+		bool Attempt() noexcept override;
+
+		const SocketAddress& mAddress;
+		bool mStarted = false;
+		Result<void> mResult;
+
+	};
+
+	/**
+	* @brief Awaitable of Socket::AsyncReceive
+	*/
+	class ReceiveAwaitable : public IOAwaitable {
+	public:
+
+		ReceiveAwaitable(Poller& poller, const Socket& sock, void* data, const size_t length) noexcept
+			: IOAwaitable(poller, sock, PollEvent::READABLE), mData(data), mLength(length) {}
+
+		Result<size_t> await_resume() noexcept { return mResult; }
+
+	private:
+
+		bool Attempt() noexcept override;
+
+		void* mData;
+		size_t mLength;
+		Result<size_t> mResult = 0;
+
+	};
+
+	/**
+	* @brief Awaitable of Socket::AsyncSend
+	*/
+	class SendAwaitable : public IOAwaitable {
+	public:
+
+		SendAwaitable(Poller& poller, const Socket& sock, const void* data, const size_t length) noexcept
+			: IOAwaitable(poller, sock, PollEvent::WRITABLE), mData(data), mLength(length) {}
+
+		Result<size_t> await_resume() noexcept { return mResult; }
+
+	private:
+
+		bool Attempt() noexcept override;
+
+		const void* mData;
+		size_t mLength;
+		size_t mSent = 0;
+		Result<size_t> mResult = 0;
+
+	};
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <socklib/Socket.h>
+#include <deque>
+#include <functional>
+
+namespace socklib {
+
+	/**
+	* @brief Sends large buffers without copying them into the kernel
+	* @details On Linux the socket is switched to SO_ZEROCOPY and sends at or above the threshold
+	*	use MSG_ZEROCOPY: the kernel pins the pages of the buffer and transmits straight from them,
+	*	so the buffer must not be modified or freed until its callback is invoked. The kernel
+	*	reports that through the error queue of the socket (MSG_ERRQUEUE), which is read by
+	*	ProcessCompletions(); when registered on a Poller those notifications are reported as
+	*	PollEvent::FAILURE. Smaller sends, sends the kernel refuses to pin (ENOBUFS) and platforms
+	*	without MSG_ZEROCOPY fall back to a regular copying send whose callback is invoked before
+	*	Send returns.
+	*	Pinning pages has a fixed cost, so zero-copy only pays off for large buffers (10 KiB is the
+	*	break even point the kernel documentation gives) and on real devices: over loopback the
+	*	kernel copies anyway, which shows up in Stats::Copied.
+	*/
+	class ZeroCopySender {
+	public:
+
+		/**
+		* @brief Callback that is invoked once the buffer of a Send can be reused
+		*/
+		using Callback = std::function<void()>;
+
+		/**
+		* @brief Counters of how the sends were performed
+		*/
+		struct Stats {
+			/**
+			* @brief Sends that were submitted with MSG_ZEROCOPY
+			*/
+			uint64_t ZeroCopy = 0;
+			/**
+			* @brief MSG_ZEROCOPY sends that the kernel ended up copying anyway
+			*/
+			uint64_t Copied = 0;
+			/**
+			* @brief Sends that used a regular copying send
+			*/
+			uint64_t Fallback = 0;
+		};
+
+		static constexpr size_t DEFAULT_THRESHOLD = 10 * KiB;
+
+		//Constructor(s) & Destructor
+		/**
+		* @brief Enables zero-copy sends on a connected socket
+		* @param sock The socket that will be used for sending
+		* @param threshold Sends smaller than this many bytes are copied
+		* @warning Buffers of pending sends must outlive the ZeroCopySender, see Pending()
+		*/
+		explicit ZeroCopySender(Socket sock, size_t threshold = DEFAULT_THRESHOLD) noexcept;
+		ZeroCopySender(const ZeroCopySender&) = delete;
+		~ZeroCopySender() noexcept = default;
+
+		/**
+		* @brief Sends data, without copying it if possible
+		* @param data Pointer to the data buffer that will be sent
+		* @param length Number of bytes that will be sent
+		* @param done Invoked once the buffer can be reused, only if the send succeeds
+		* @return Number of bytes that were sent (may be less than length on non-blocking sockets,
+		*	the rest has to be sent with another call), or the error code of the failure
+		*/
+		Result<size_t> Send(const void* data, size_t length, Callback done) noexcept;
+
+		/**
+		* @brief Reads the completion notifications and invokes the callbacks of the finished sends
+		* @details Never blocks
+		* @return The number of callbacks that were invoked
+		*/
+		size_t ProcessCompletions() noexcept;
+
+		/**
+		* @brief Blocks until every pending send has completed
+		* @param millis Milliseconds to wait before giving up, a negative value means wait forever
+		* @return True if there are no pending sends left
+		*/
+		bool WaitForCompletions(int32_t millis = -1) noexcept;
+
+		/**
+		* @brief Getter for the number of sends whose buffer is still in use by the kernel
+		*/
+		[[nodiscard]] size_t Pending() const noexcept { return mPending.size(); }
+
+		/**
+		* @brief Checks whether the kernel accepted SO_ZEROCOPY for the socket
+		*/
+		[[nodiscard]] bool IsEnabled() const noexcept { return mEnabled; }
+
+		[[nodiscard]] const Stats& GetStats() const noexcept { return mStats; }
+
+		[[nodiscard]] const Socket& GetSocket() const noexcept { return mSock; }
+
+		ZeroCopySender& operator=(const ZeroCopySender&) = delete;
+
+	private:
+
+		struct Entry {
+			uint32_t Id;
+			Callback Done;
+		};
+
+		size_t Complete(uint32_t first, uint32_t last) noexcept;
+
+	private:
+
+		Socket mSock;
+
+		size_t mThreshold;
+
+		bool mEnabled = false;
+
+		//Every successful MSG_ZEROCOPY send gets the next id of this per socket counter
+		uint32_t mNextId = 0;
+
+		std::deque<Entry> mPending;
+
+		Stats mStats;
+
+	};
+
+}
@@ -94,6 +94,48 @@ project "socklib-tests"
 			"DEBUG_BUILD"
 		}
 
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+
+project "socklib-bench"
+	location "bench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+
+	targetdir("build/bin/" .. outputdir .. "/%{prj.name}")
+	objdir("build/bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"bench/src/**.h",
+		"bench/src/**.cpp"
+	}
+
+	includedirs
+	{
+		"include",
+	}
+
+	links
+	{
+		"socklib"
+	}
+
+	filter "system:linux"
+		toolset("clang")
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+		defines
+		{
+			"DEBUG_BUILD"
+		}
+
 	filter "configurations:Release"
 		runtime "Release"
 		optimize "on"
\ No newline at end of file
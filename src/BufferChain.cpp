@@ -0,0 +1,133 @@
+#include <socklib/BufferChain.h>
+#include <algorithm>
+#include <cstring>
+
+namespace socklib {
+
+	BufferChain::BufferChain(PooledBuffer buffer, const size_t length) noexcept
+	{
+		SOCKLIB_ASSERT(length <= buffer.Size(), "The length is past the end of the buffer!");
+		if (length == 0) return;
+		mSegments.push_back({ std::move(buffer), 0, length });
+		mSize = length;
+	}
+
+	BufferChain BufferChain::Copy(const void* data, const size_t length) noexcept
+	{
+		//A single buffer while it fits the largest class, so small payloads are a single segment
+		static constexpr size_t LARGEST = BufferPool::SIZE_CLASSES[std::size(BufferPool::SIZE_CLASSES) - 1];
+		BufferChain chain;
+		for (size_t copied = 0; copied < length;)
+		{
+			const size_t bytes = std::min(length - copied, LARGEST);
+			PooledBuffer buffer = BufferPool::Acquire(bytes);
+			if (!buffer.IsValid()) return {};
+			memcpy(buffer.Data(), static_cast<const BYTE*>(data) + copied, bytes);
+			chain.Append(BufferChain(std::move(buffer), bytes));
+			copied += bytes;
+		}
+		return chain;
+	}
+
+	void BufferChain::Append(const BufferChain& other) noexcept
+	{
+		mSegments.insert(mSegments.end(), other.mSegments.begin(), other.mSegments.end());
+		mSize += other.mSize;
+	}
+
+	BufferChain BufferChain::Slice(size_t offset, size_t length) const noexcept
+	{
+		BufferChain slice;
+		for (const Segment& segment : mSegments)
+		{
+			if (length == 0) break;
+			if (offset >= segment.Length)
+			{
+				offset -= segment.Length;
+				continue;
+			}
+			const size_t bytes = std::min(segment.Length - offset, length);
+			slice.mSegments.push_back({ segment.Buffer, segment.Offset + offset, bytes });
+			slice.mSize += bytes;
+			length -= bytes;
+			offset = 0;
+		}
+		return slice;
+	}
+
+	size_t BufferChain::Fill(size_t offset, const std::span<IOBuffer> buffers) const noexcept
+	{
+		size_t count = 0;
+		for (const Segment& segment : mSegments)
+		{
+			if (count == buffers.size()) break;
+			if (offset >= segment.Length)
+			{
+				offset -= segment.Length;
+				continue;
+			}
+			buffers[count++] = IOBuffer(segment.Data() + offset, segment.Length - offset);
+			offset = 0;
+		}
+		return count;
+	}
+
+	SendQueue::SendQueue(Socket sock) noexcept
+		: mSock(std::move(sock))
+	{
+		SOCKLIB_ASSERT(mSock.FileNo() != INVALID_SOCKET, "Socket is not opened!");
+	}
+
+	void SendQueue::Push(BufferChain chain) noexcept
+	{
+		if (chain.Empty()) return;
+		mPending += chain.Size();
+		mChains.push_back(std::move(chain));
+	}
+
+	Result<size_t> SendQueue::Send() noexcept
+	{
+		size_t sent = 0;
+		IOBuffer buffers[MAX_BUFFERS];
+		while (!mChains.empty())
+		{
+			//Gather the segments of as many chains as fit, starting where the last send stopped
+			size_t count = 0;
+			size_t offset = mOffset;
+			for (const BufferChain& chain : mChains)
+			{
+				if (count == MAX_BUFFERS) break;
+				count += chain.Fill(offset, std::span<IOBuffer>(buffers + count, MAX_BUFFERS - count));
+				offset = 0;
+			}
+
+			const Result<size_t> bytes = mSock.TrySendV({ buffers, count });
+			if (!bytes)
+			{
+				if (sent > 0 && WouldBlock(bytes.error())) break;
+				return bytes;
+			}
+			Consume(*bytes);
+			sent += *bytes;
+		}
+		return sent;
+	}
+
+	void SendQueue::Consume(size_t bytes) noexcept
+	{
+		mPending -= bytes;
+		while (bytes > 0)
+		{
+			const size_t left = mChains.front().Size() - mOffset;
+			if (bytes < left)
+			{
+				mOffset += bytes;
+				return;
+			}
+			bytes -= left;
+			mChains.pop_front();//Releases the buffers, unless other queues still hold the chain
+			mOffset = 0;
+		}
+	}
+
+}
@@ -0,0 +1,398 @@
+#include <socklib/BufferPool.h>
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+#ifndef PLATFORM_WINDOWS
+	#include <sys/mman.h>
+#endif
+
+namespace socklib {
+
+	static constexpr size_t CLASSES = std::size(BufferPool::SIZE_CLASSES);
+
+	//Class of the buffers that are too large to be pooled
+	static constexpr uint32_t OVERSIZED = static_cast<uint32_t>(CLASSES);
+
+	//Buffers a thread keeps per class, a few MiB in total at most
+	static constexpr size_t CACHE_LIMITS[CLASSES] = { 256, 64, 32, 4 };
+
+	//Arenas are made of whole huge pages, the size x86-64 and ARM64 use by default
+	static constexpr size_t HUGE_PAGE_SIZE = 2 * MiB;
+
+	//Smallest page size of the supported platforms, touching every one of these faults in every page
+	static constexpr size_t SMALL_PAGE_SIZE = 4 * KiB;
+
+	static Result<BYTE*> MapArena(size_t bytes, const ArenaOptions& options, ArenaPages& pages) noexcept;
+
+	//Counters of a single thread, only that thread writes them
+	struct Counters {
+		std::atomic<uint64_t> Hits = 0;
+		std::atomic<uint64_t> Misses = 0;
+		std::atomic<int64_t> Outstanding = 0;
+		std::atomic<int64_t> Cached = 0;
+
+		static void Add(std::atomic<uint64_t>& counter, const uint64_t value) noexcept { counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+		static void Add(std::atomic<int64_t>& counter, const int64_t value) noexcept { counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+	};
+
+	struct ThreadCache;
+
+	//Lists every thread refills its cache from, blocks are kept as raw memory
+	struct Central {
+		std::mutex Mutex;
+		std::vector<void*> Free[CLASSES];
+		std::vector<ThreadCache*> Caches;
+		//Counters of the threads that already exited, and of releases that happened without a cache
+		uint64_t Hits = 0;
+		uint64_t Misses = 0;
+		int64_t Outstanding = 0;
+		int64_t Cached = 0;
+		int64_t Reserved = 0;
+	};
+
+	//Never destroyed, so threads that exit during static destruction can still hand their buffers back
+	static Central& GetCentral() noexcept
+	{
+		static Central* central = new Central();
+		return *central;
+	}
+
+	struct ThreadCache {
+		std::vector<void*> Free[CLASSES];
+		Counters Stats;
+
+		ThreadCache() noexcept;
+		~ThreadCache() noexcept;
+	};
+
+	enum class CacheState : uint8_t { Unused, Alive, Destroyed };
+	static thread_local CacheState tState = CacheState::Unused;
+
+	ThreadCache::ThreadCache() noexcept
+	{
+		for (size_t i = 0; i < CLASSES; i++)
+			Free[i].reserve(CACHE_LIMITS[i] + 1);
+
+		Central& central = GetCentral();
+		const std::scoped_lock lock(central.Mutex);
+		central.Caches.push_back(this);
+	}
+
+	ThreadCache::~ThreadCache() noexcept
+	{
+		tState = CacheState::Destroyed;//Buffers released by the thread from now on go straight to the shared lists
+		Central& central = GetCentral();
+		const std::scoped_lock lock(central.Mutex);
+		for (size_t i = 0; i < CLASSES; i++)
+			central.Free[i].insert(central.Free[i].end(), Free[i].begin(), Free[i].end());
+		central.Hits += Stats.Hits;
+		central.Misses += Stats.Misses;
+		central.Outstanding += Stats.Outstanding;
+		central.Cached += Stats.Cached;
+		std::erase(central.Caches, this);
+	}
+
+	//The cache of the calling thread, nullptr once it was destroyed at thread exit
+	static ThreadCache* LocalCache() noexcept
+	{
+		if (tState == CacheState::Destroyed) return nullptr;
+		static thread_local ThreadCache cache;
+		tState = CacheState::Alive;
+		return &cache;
+	}
+
+	static uint32_t ClassOf(const size_t size) noexcept
+	{
+		for (uint32_t i = 0; i < CLASSES; i++)
+			if (size <= BufferPool::SIZE_CLASSES[i]) return i;
+		return OVERSIZED;
+	}
+
+	PooledBuffer::PooledBuffer(const PooledBuffer& other) noexcept
+		: mBlock(other.mBlock)
+	{
+		if (mBlock != nullptr)
+			mBlock->Refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+		: mBlock(std::exchange(other.mBlock, nullptr)) {}
+
+	void PooledBuffer::Reset() noexcept
+	{
+		if (mBlock == nullptr) return;
+		if (mBlock->Refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			BufferPool::Release(mBlock);
+		mBlock = nullptr;
+	}
+
+	PooledBuffer& PooledBuffer::operator=(const PooledBuffer& rhs) noexcept
+	{
+		if (this == &rhs) return *this;
+		Reset();
+		mBlock = rhs.mBlock;
+		if (mBlock != nullptr)
+			mBlock->Refs.fetch_add(1, std::memory_order_relaxed);
+		return *this;
+	}
+
+	PooledBuffer& PooledBuffer::operator=(PooledBuffer&& rhs) noexcept
+	{
+		if (this == &rhs) return *this;
+		Reset();
+		mBlock = std::exchange(rhs.mBlock, nullptr);
+		return *this;
+	}
+
+	PooledBuffer BufferPool::Acquire(const size_t size) noexcept
+	{
+		using Block = PooledBuffer::Block;
+		const uint32_t cls = ClassOf(size);
+		const size_t bytes = cls == OVERSIZED ? size : SIZE_CLASSES[cls];
+		ThreadCache* cache = LocalCache();
+
+		void* memory = nullptr;
+		if (cls != OVERSIZED)
+		{
+			if (cache != nullptr && cache->Free[cls].empty())
+			{
+				//Refill half of the cache at once, so the lock is taken once per batch
+				Central& central = GetCentral();
+				const std::scoped_lock lock(central.Mutex);
+				std::vector<void*>& shared = central.Free[cls];
+				const size_t count = std::min(shared.size(), CACHE_LIMITS[cls] / 2 + 1);
+				cache->Free[cls].insert(cache->Free[cls].end(), shared.end() - static_cast<std::ptrdiff_t>(count), shared.end());
+				shared.resize(shared.size() - count);
+				central.Cached -= static_cast<int64_t>(count * bytes);
+				Counters::Add(cache->Stats.Cached, static_cast<int64_t>(count * bytes));
+			}
+
+			if (cache != nullptr && !cache->Free[cls].empty())
+			{
+				memory = cache->Free[cls].back();
+				cache->Free[cls].pop_back();
+				Counters::Add(cache->Stats.Cached, -static_cast<int64_t>(bytes));
+			}
+			else if (cache == nullptr)
+			{
+				Central& central = GetCentral();
+				const std::scoped_lock lock(central.Mutex);
+				if (!central.Free[cls].empty())
+				{
+					memory = central.Free[cls].back();
+					central.Free[cls].pop_back();
+					central.Cached -= static_cast<int64_t>(bytes);
+				}
+			}
+		}
+
+		const bool hit = memory != nullptr;
+		if (!hit)
+		{
+			memory = ::operator new(sizeof(Block) + bytes, std::align_val_t(alignof(Block)), std::nothrow);
+			if (memory == nullptr) return {};
+		}
+
+		if (cache != nullptr)
+		{
+			Counters::Add(hit ? cache->Stats.Hits : cache->Stats.Misses, 1);
+			Counters::Add(cache->Stats.Outstanding, static_cast<int64_t>(bytes));
+		}
+		else
+		{
+			Central& central = GetCentral();
+			const std::scoped_lock lock(central.Mutex);
+			(hit ? central.Hits : central.Misses)++;
+			central.Outstanding += static_cast<int64_t>(bytes);
+		}
+
+		auto* block = static_cast<Block*>(memory);
+		if (!hit)
+		{
+			new (block) Block();
+			block->Class = cls;
+			block->Size = bytes;
+		}
+		block->Refs.store(1, std::memory_order_relaxed);
+		return PooledBuffer(block);
+	}
+
+	void BufferPool::Release(PooledBuffer::Block* block) noexcept
+	{
+		using Block = PooledBuffer::Block;
+		const uint32_t cls = block->Class;
+		const size_t bytes = block->Size;
+		ThreadCache* cache = LocalCache();
+
+		if (cache != nullptr)
+			Counters::Add(cache->Stats.Outstanding, -static_cast<int64_t>(bytes));
+		else
+		{
+			Central& central = GetCentral();
+			const std::scoped_lock lock(central.Mutex);
+			central.Outstanding -= static_cast<int64_t>(bytes);
+		}
+
+		if (cls == OVERSIZED)
+		{
+			block->~Block();
+			::operator delete(block, std::align_val_t(alignof(Block)));
+			return;
+		}
+
+		if (cache == nullptr)
+		{
+			Central& central = GetCentral();
+			const std::scoped_lock lock(central.Mutex);
+			central.Free[cls].push_back(block);
+			central.Cached += static_cast<int64_t>(bytes);
+			return;
+		}
+
+		cache->Free[cls].push_back(block);
+		Counters::Add(cache->Stats.Cached, static_cast<int64_t>(bytes));
+		if (cache->Free[cls].size() > CACHE_LIMITS[cls])
+		{
+			//Spill half of the cache, other threads may be the ones acquiring
+			const size_t count = cache->Free[cls].size() / 2;
+			Central& central = GetCentral();
+			const std::scoped_lock lock(central.Mutex);
+			central.Free[cls].insert(central.Free[cls].end(), cache->Free[cls].end() - static_cast<std::ptrdiff_t>(count), cache->Free[cls].end());
+			cache->Free[cls].resize(cache->Free[cls].size() - count);
+			central.Cached += static_cast<int64_t>(count * bytes);
+			Counters::Add(cache->Stats.Cached, -static_cast<int64_t>(count * bytes));
+		}
+	}
+
+	Result<ArenaPages> BufferPool::Reserve(const size_t size, const size_t count, const ArenaOptions& options) noexcept
+	{
+		using Block = PooledBuffer::Block;
+		const uint32_t cls = ClassOf(size);
+		if (cls == OVERSIZED || count == 0)
+			return Unexpected(std::make_error_code(std::errc::invalid_argument));
+
+		const size_t stride = sizeof(Block) + SIZE_CLASSES[cls];
+		const size_t bytes = (count * stride + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+		ArenaPages pages = ArenaPages::Normal;
+		const Result<BYTE*> arena = MapArena(bytes, options, pages);
+		if (!arena)
+			return Unexpected(arena.error());
+
+		if (options.Prefault)
+		{
+			for (size_t offset = 0; offset < bytes; offset += SMALL_PAGE_SIZE)
+				static_cast<volatile BYTE*>(*arena)[offset] = 0;
+		}
+
+		const size_t blocks = bytes / stride;
+		std::vector<void*> carved;
+		carved.reserve(blocks);
+		for (size_t i = 0; i < blocks; i++)
+		{
+			auto* block = new (*arena + i * stride) Block();
+			block->Class = cls;
+			block->Size = SIZE_CLASSES[cls];
+			block->Arena = true;
+			carved.push_back(block);
+		}
+
+		Central& central = GetCentral();
+		const std::scoped_lock lock(central.Mutex);
+		central.Free[cls].insert(central.Free[cls].end(), carved.rbegin(), carved.rend());//Handed out in address order
+		central.Cached += static_cast<int64_t>(blocks * SIZE_CLASSES[cls]);
+		central.Reserved += static_cast<int64_t>(bytes);
+		return pages;
+	}
+
+	BufferPool::Stats BufferPool::GetStats() noexcept
+	{
+		Central& central = GetCentral();
+		const std::scoped_lock lock(central.Mutex);
+		Stats stats;
+		stats.Hits = central.Hits;
+		stats.Misses = central.Misses;
+		stats.Outstanding = central.Outstanding;
+		stats.Cached = central.Cached;
+		stats.Reserved = central.Reserved;
+		for (const ThreadCache* cache : central.Caches)
+		{
+			stats.Hits += cache->Stats.Hits.load(std::memory_order_relaxed);
+			stats.Misses += cache->Stats.Misses.load(std::memory_order_relaxed);
+			stats.Outstanding += cache->Stats.Outstanding.load(std::memory_order_relaxed);
+			stats.Cached += cache->Stats.Cached.load(std::memory_order_relaxed);
+		}
+		return stats;
+	}
+
+	void BufferPool::Trim() noexcept
+	{
+		using Block = PooledBuffer::Block;
+		Central& central = GetCentral();
+		const std::scoped_lock lock(central.Mutex);
+		for (size_t i = 0; i < CLASSES; i++)
+		{
+			//The buffers of the arenas stay, they can't be freed one by one
+			const auto freed = std::partition(central.Free[i].begin(), central.Free[i].end(), [](void* memory) { return static_cast<Block*>(memory)->Arena; });
+			for (auto it = freed; it != central.Free[i].end(); ++it)
+			{
+				static_cast<Block*>(*it)->~Block();
+				::operator delete(*it, std::align_val_t(alignof(Block)));
+			}
+			central.Cached -= static_cast<int64_t>(static_cast<size_t>(central.Free[i].end() - freed) * SIZE_CLASSES[i]);
+			central.Free[i].erase(freed, central.Free[i].end());
+			central.Free[i].shrink_to_fit();
+		}
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_WINDOWS
+	static Result<BYTE*> MapArena(const size_t bytes, const ArenaOptions&, ArenaPages& pages) noexcept
+	{
+		//Large pages need the SeLockMemoryPrivilege, which services rarely have
+		void* arena = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (arena == nullptr)
+			return Unexpected(std::error_code(static_cast<int>(GetLastError()), std::system_category()));
+		pages = ArenaPages::Normal;
+		return static_cast<BYTE*>(arena);
+	}
+#else
+	static Result<BYTE*> MapArena(const size_t bytes, const ArenaOptions& options, ArenaPages& pages) noexcept
+	{
+	#ifdef PLATFORM_LINUX
+		if (options.HugePages)
+		{
+			void* arena = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (arena != MAP_FAILED)
+			{
+				pages = ArenaPages::Huge;
+				return static_cast<BYTE*>(arena);
+			}
+			//The hugetlbfs pool is empty unless the administrator sized it, fall back to transparent huge pages
+		}
+	#endif
+
+		//Map an extra huge page, so the arena can start on a huge page boundary and the kernel can back all of it with them
+		void* range = mmap(nullptr, bytes + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (range == MAP_FAILED)
+			return Unexpected(std::error_code(errno, std::system_category()));
+		auto* first = static_cast<BYTE*>(range);
+		auto* arena = reinterpret_cast<BYTE*>((reinterpret_cast<uintptr_t>(first) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+		if (arena != first)
+			munmap(first, static_cast<size_t>(arena - first));
+		if (arena + bytes != first + bytes + HUGE_PAGE_SIZE)
+			munmap(arena + bytes, static_cast<size_t>(first + bytes + HUGE_PAGE_SIZE - (arena + bytes)));
+
+		pages = ArenaPages::Normal;
+	#ifdef MADV_HUGEPAGE
+		if (options.HugePages && madvise(arena, bytes, MADV_HUGEPAGE) == 0)
+			pages = ArenaPages::Transparent;
+	#endif
+		return arena;
+	}
+#endif
+
+}
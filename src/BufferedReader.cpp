@@ -0,0 +1,96 @@
+#include <socklib/BufferedReader.h>
+
+namespace socklib {
+
+	BufferedReader::BufferedReader(Socket sock, const size_t capacity) noexcept
+		: mSock(std::move(sock)), mBuffer(capacity) {}
+
+	Result<std::span<const BYTE>> BufferedReader::Peek(const size_t length) noexcept
+	{
+		if (const Result<void> filled = Fill(length); !filled)
+			return Unexpected(filled.error());
+		return mBuffer.Readable().first(length);
+	}
+
+	Result<std::span<const BYTE>> BufferedReader::ReadExact(const size_t length) noexcept
+	{
+		if (const Result<void> filled = Fill(length); !filled)
+			return Unexpected(filled.error());
+
+		//Consuming doesn't touch the memory, the view stays intact until the next receive
+		const std::span<const BYTE> frame = mBuffer.Readable().first(length);
+		mBuffer.Consume(length);
+		mScanned = mScanned > length ? mScanned - length : 0;
+		return frame;
+	}
+
+	Result<std::span<const BYTE>> BufferedReader::ReadUntil(const std::string_view delimiter) noexcept
+	{
+		SOCKLIB_ASSERT(!delimiter.empty(), "The delimiter can't be empty!");
+		while (true)
+		{
+			const std::span<const BYTE> readable = mBuffer.Readable();
+			const std::string_view text(reinterpret_cast<const char*>(readable.data()), readable.size());
+
+			//A delimiter may have been cut in half by the end of the previous receive
+			const size_t from = mScanned >= delimiter.size() ? mScanned - delimiter.size() + 1 : 0;
+			const size_t found = text.find(delimiter, from);
+			if (found != std::string_view::npos)
+			{
+				const size_t length = found + delimiter.size();
+				mBuffer.Consume(length);
+				mScanned = 0;
+				return readable.first(length);
+			}
+			mScanned = text.size();
+
+			if (mBuffer.Full())
+				return Unexpected(std::make_error_code(std::errc::message_size));
+			if (mEndOfStream)
+				return Unexpected(std::make_error_code(std::errc::no_message));
+			if (const Result<void> received = ReceiveMore(); !received)
+				return Unexpected(received.error());
+		}
+	}
+
+	Result<size_t> BufferedReader::Read(void* data, const size_t length) noexcept
+	{
+		if (mBuffer.Empty() && !mEndOfStream && length > 0)
+		{
+			if (const Result<void> received = ReceiveMore(); !received)
+				return Unexpected(received.error());
+		}
+
+		const size_t bytes = mBuffer.Read(data, length);
+		mScanned = mScanned > bytes ? mScanned - bytes : 0;
+		return bytes;
+	}
+
+	Result<void> BufferedReader::Fill(const size_t length) noexcept
+	{
+		if (length > mBuffer.Capacity())
+			return Unexpected(std::make_error_code(std::errc::message_size));
+
+		while (mBuffer.Size() < length)
+		{
+			if (mEndOfStream)
+				return Unexpected(std::make_error_code(std::errc::no_message));
+			if (const Result<void> received = ReceiveMore(); !received)
+				return received;
+		}
+		return {};
+	}
+
+	Result<void> BufferedReader::ReceiveMore() noexcept
+	{
+		SOCKLIB_ASSERT(IsValid(), "The BufferedReader has no buffer!");
+		const Result<size_t> bytes = mBuffer.Receive(mSock);
+		mReceives++;
+		if (!bytes)
+			return Unexpected(bytes.error());
+		if (*bytes == 0)
+			mEndOfStream = true;
+		return {};
+	}
+
+}
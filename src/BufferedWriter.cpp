@@ -0,0 +1,209 @@
+#include <socklib/BufferedWriter.h>
+#include <algorithm>
+#include <cstring>
+#ifndef PLATFORM_WINDOWS
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+#endif
+
+//Declaration of helper functions
+static socklib::Result<void> IgnoreWouldBlock(const socklib::Result<void>& result) noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	BufferedWriter::BufferedWriter(Socket sock, const BufferedWriterOptions& options) noexcept
+		: mSock(std::move(sock)), mOptions(options)
+	{
+		SOCKLIB_ASSERT(mSock.FileNo() != INVALID_SOCKET, "Socket is not opened!");
+		//Room for a full buffer plus a write just below the threshold, if the pool is out of memory Append() tries again
+		mBuffer = BufferPool::Acquire(2 * mOptions.Threshold);
+		Cork();
+	}
+
+	BufferedWriter::~BufferedWriter() noexcept
+	{
+		if (Buffered() > 0 || mHeld)
+			(void)Flush();//Nobody is left to report a failure to
+	}
+
+	Result<void> BufferedWriter::Write(const void* data, const size_t length) noexcept
+	{
+		if (length >= mOptions.Threshold)
+		{
+			//Send the buffered bytes and the new ones with a single call, without copying the new ones
+			const IOBuffer buffers[2] = { { mBuffer.Data() + mStart, Buffered() }, { data, length } };
+			const std::span<const IOBuffer> pending = Buffered() > 0 ? std::span<const IOBuffer>(buffers) : std::span<const IOBuffer>(buffers + 1, 1);
+			const Result<size_t> bytes = SendBuffers(pending, mOptions.Cork);
+			if (!bytes && !WouldBlock(bytes.error()))
+				return Unexpected(bytes.error());
+
+			const size_t sent = bytes.value_or(0);
+			const size_t fromBuffer = std::min(sent, Buffered());
+			Consume(fromBuffer);
+			const size_t fromData = sent - fromBuffer;
+			if (fromData == length) return {};
+
+			//Whatever didn't make it has to be buffered after all
+			if (const Result<void> appended = Append(static_cast<const BYTE*>(data) + fromData, length - fromData); !appended)
+				return appended;
+			return IgnoreWouldBlock(Drain(mOptions.Cork));
+		}
+
+		if (const Result<void> appended = Append(data, length); !appended)
+			return appended;
+		if (Buffered() >= mOptions.Threshold)
+			return IgnoreWouldBlock(Drain(mOptions.Cork));
+		if (IsDue())
+			return IgnoreWouldBlock(Flush());
+		return {};
+	}
+
+	Result<void> BufferedWriter::Flush() noexcept
+	{
+		if (const Result<void> drained = Drain(false); !drained)
+			return drained;
+		Push();
+		return {};
+	}
+
+	Result<void> BufferedWriter::FlushIfDue() noexcept
+	{
+		if (!IsDue()) return {};
+		return Flush();
+	}
+
+	bool BufferedWriter::IsDue() const noexcept
+	{
+		return mOptions.Delay > std::chrono::microseconds::zero() && Buffered() > 0 && std::chrono::steady_clock::now() >= Deadline();
+	}
+
+	Result<void> BufferedWriter::Append(const void* data, const size_t length) noexcept
+	{
+		if (length == 0) return {};
+		if (mEnd + length > mBuffer.Size())
+		{
+			if (Buffered() + length <= mBuffer.Size())
+				memmove(mBuffer.Data(), mBuffer.Data() + mStart, Buffered());//Dropping the bytes that were sent already is enough
+			else
+			{
+				//Only a non-blocking socket that can't keep up (or a pool that ran out of memory earlier) gets here
+				PooledBuffer larger = BufferPool::Acquire(std::max({ Buffered() + length, 2 * mBuffer.Size(), 2 * mOptions.Threshold }));
+				if (!larger.IsValid())
+					return Unexpected(std::make_error_code(std::errc::not_enough_memory));
+				if (Buffered() > 0)
+					memcpy(larger.Data(), mBuffer.Data() + mStart, Buffered());
+				mBuffer = std::move(larger);
+			}
+			mEnd -= mStart;
+			mStart = 0;
+		}
+		if (Buffered() == 0 && mOptions.Delay > std::chrono::microseconds::zero())
+			mOldest = std::chrono::steady_clock::now();
+		memcpy(mBuffer.Data() + mEnd, data, length);
+		mEnd += length;
+		return {};
+	}
+
+	void BufferedWriter::Consume(const size_t bytes) noexcept
+	{
+		mStart += bytes;
+		if (mStart == mEnd)
+			mStart = mEnd = 0;
+	}
+
+	Result<void> BufferedWriter::Drain(const bool more) noexcept
+	{
+		while (Buffered() > 0)
+		{
+			const IOBuffer buffer(mBuffer.Data() + mStart, Buffered());
+			const Result<size_t> bytes = SendBuffers({ &buffer, 1 }, more);
+			if (!bytes)
+				return Unexpected(bytes.error());
+			Consume(*bytes);
+		}
+		return {};
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_LINUX
+	Result<size_t> BufferedWriter::SendBuffers(const std::span<const IOBuffer> buffers, const bool more) noexcept
+	{
+		msghdr message = {};
+		message.msg_iov = reinterpret_cast<iovec*>(const_cast<IOBuffer*>(buffers.data()));
+		message.msg_iovlen = buffers.size();
+
+		mSends++;
+		while (true)
+		{
+			const ssize_t bytes = sendmsg(mSock.FileNo(), &message, more ? MSG_MORE : 0);
+			if (bytes != -1)
+			{
+				mHeld = more;//A send without MSG_MORE pushes out whatever was held back
+				return static_cast<size_t>(bytes);
+			}
+			if (errno != EINTR)
+				return Unexpected(std::error_code(errno, std::system_category()));
+		}
+	}
+
+	void BufferedWriter::Cork() const noexcept {}//MSG_MORE works per call
+
+	void BufferedWriter::Push() noexcept
+	{
+		if (!mHeld) return;
+		//Clearing TCP_CORK pushes the pending frames even if the socket was never corked
+		const int off = 0;
+		setsockopt(mSock.FileNo(), IPPROTO_TCP, TCP_CORK, &off, sizeof(off));
+		mHeld = false;
+	}
+#else
+	Result<size_t> BufferedWriter::SendBuffers(const std::span<const IOBuffer> buffers, bool) noexcept
+	{
+		mSends++;
+		const Result<size_t> bytes = mSock.TrySendV(buffers);
+		if (bytes && *bytes > 0 && mOptions.Cork)
+			mHeld = true;
+		return bytes;
+	}
+
+	void BufferedWriter::Cork() const noexcept
+	{
+	#ifdef TCP_NOPUSH
+		if (!mOptions.Cork) return;
+		const int on = 1;
+		setsockopt(mSock.FileNo(), IPPROTO_TCP, TCP_NOPUSH, &on, sizeof(on));
+	#endif
+	}
+
+	void BufferedWriter::Push() noexcept
+	{
+	#ifdef TCP_NOPUSH
+		if (mHeld)
+		{
+			//Clearing TCP_NOPUSH sends the partial segment, then the socket is corked again
+			const int off = 0;
+			setsockopt(mSock.FileNo(), IPPROTO_TCP, TCP_NOPUSH, &off, sizeof(off));
+			Cork();
+		}
+	#endif
+		mHeld = false;
+	}
+#endif
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+//Sends that would block leave the bytes buffered, they aren't a failure of Write
+static socklib::Result<void> IgnoreWouldBlock(const socklib::Result<void>& result) noexcept
+{
+	if (!result && socklib::WouldBlock(result.error()))
+		return {};
+	return result;
+}
@@ -0,0 +1,347 @@
+#include <socklib/ConnectionPool.h>
+#include <socklib/Poller.h>
+#include <algorithm>
+
+//Declaration of helper functions
+static bool IsHealthy(const socklib::Socket& sock) noexcept;
+static bool IsConnected(socklib::SOCKET sock) noexcept;
+static std::error_code Exhausted() noexcept;
+static size_t Stripe() noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	PooledConnection::PooledConnection(PooledConnection&& other) noexcept
+		: mPool(std::exchange(other.mPool, nullptr)), mSock(std::move(other.mSock)), mAddress(other.mAddress), mEndpoint(std::move(other.mEndpoint)), mReused(other.mReused) {}
+
+	PooledConnection& PooledConnection::operator=(PooledConnection&& rhs) noexcept
+	{
+		if (this == &rhs) return *this;
+		Release();
+		mPool = std::exchange(rhs.mPool, nullptr);
+		mSock = std::move(rhs.mSock);
+		mAddress = rhs.mAddress;
+		mEndpoint = std::move(rhs.mEndpoint);
+		mReused = rhs.mReused;
+		return *this;
+	}
+
+	void PooledConnection::Release() noexcept
+	{
+		if (mPool == nullptr) return;
+		std::exchange(mPool, nullptr)->Return(std::move(mSock), std::move(mEndpoint), mAddress, true);
+	}
+
+	void PooledConnection::Discard() noexcept
+	{
+		if (mPool == nullptr) return;
+		std::exchange(mPool, nullptr)->Return(std::move(mSock), std::move(mEndpoint), mAddress, false);
+	}
+
+	ConnectionPool::ConnectionPool(const ConnectionPoolOptions& options) noexcept
+		: mOptions(options), mDirectories(std::make_unique<Directory[]>(SHARDS)), mShards(std::make_unique<Shard[]>(SHARDS))
+	{
+		SOCKLIB_ASSERT(mOptions.MaxIdle <= mOptions.MaxTotal, "More idle connections than connections are allowed!");
+	}
+
+	Result<PooledConnection> ConnectionPool::Acquire(const SocketAddress& address) noexcept
+	{
+		//The shard of this thread first, then the connections other threads released
+		const size_t stripe = Stripe();
+		for (size_t i = 0; i < SHARDS; i++)
+		{
+			Shard& shard = ShardOf(address, stripe + i);
+			Socket sock;
+			std::shared_ptr<Endpoint> endpoint;
+			while (Take(shard, address, sock, endpoint))
+			{
+				//The health check is a system call, it is made without holding the lock
+				if (IsHealthy(sock))
+				{
+					mHits.fetch_add(1, std::memory_order_relaxed);
+					return PooledConnection(this, std::move(sock), address, std::move(endpoint), true);
+				}
+				mEvicted.fetch_add(1, std::memory_order_relaxed);
+				Return(std::move(sock), std::move(endpoint), address, false);
+			}
+		}
+
+		std::shared_ptr<Endpoint> endpoint = Open(address);
+		if (Reserve(*endpoint, 1) == 0)//Taken before connecting, so concurrent leases respect the limit
+			return Unexpected(Exhausted());
+
+		mMisses.fetch_add(1, std::memory_order_relaxed);
+		Socket sock(address.Family(), SocketType::STREAM, IPPROTO_TCP);
+		const Result<void> connected = mOptions.ConnectTimeout > 0 ? sock.TryConnect(address, mOptions.ConnectTimeout) : sock.TryConnect(address);
+		if (!connected)
+		{
+			Return(std::move(sock), std::move(endpoint), address, false);
+			return Unexpected(connected.error());
+		}
+		return PooledConnection(this, std::move(sock), address, std::move(endpoint), false);
+	}
+
+	size_t ConnectionPool::WarmUp(const std::span<const SocketAddress> addresses, const size_t count, const uint32_t timeout) noexcept
+	{
+		struct Attempt {
+			Socket Sock;
+			size_t Address;
+			std::shared_ptr<Endpoint> Owner;
+		};
+
+		//Take the slots first, then start every connect without waiting for any of them
+		size_t opened = 0;
+		std::vector<Attempt> attempts;
+		SocketOptions options;
+		options.NonBlocking = true;
+		for (size_t i = 0; i < addresses.size(); i++)
+		{
+			std::shared_ptr<Endpoint> endpoint = Open(addresses[i]);
+			const size_t idle = endpoint->Idle.load(std::memory_order_relaxed);
+			const size_t slots = Reserve(*endpoint, std::min(count, mOptions.MaxIdle - std::min(mOptions.MaxIdle, idle)));
+			for (size_t slot = 0; slot < slots; slot++)
+			{
+				Socket sock(addresses[i].Family(), SocketType::STREAM, IPPROTO_TCP, options);
+				const Result<void> connected = sock.TryConnect(addresses[i]);
+				if (connected || !WouldBlock(connected.error()))
+				{
+					sock.SetBlocking(true);
+					opened += connected ? 1 : 0;
+					Return(std::move(sock), endpoint, addresses[i], connected.has_value());
+					continue;
+				}
+				attempts.push_back({ std::move(sock), i, endpoint });
+			}
+		}
+
+		Poller poller;
+		size_t pending = attempts.size();
+		for (Attempt& attempt : attempts)
+		{
+			poller.Add(attempt.Sock, PollEvent::WRITABLE, [this, &poller, &attempt, &addresses, &pending, &opened](const SOCKET fd, PollEvent)
+			{
+				const bool connected = IsConnected(fd);
+				poller.Remove(fd);
+				attempt.Sock.SetBlocking(true);
+				opened += connected ? 1 : 0;
+				pending--;
+				Return(std::move(attempt.Sock), std::move(attempt.Owner), addresses[attempt.Address], connected);
+			});
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		while (pending > 0)
+		{
+			int32_t millis = -1;
+			if (timeout > 0)
+			{
+				millis = static_cast<int32_t>(std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+				if (millis <= 0) break;
+			}
+			poller.Poll(millis);
+		}
+
+		//Whatever didn't make it in time gives its slot back
+		for (Attempt& attempt : attempts)
+		{
+			if (attempt.Sock.FileNo() == INVALID_SOCKET) continue;
+			poller.Remove(attempt.Sock);
+			Return(std::move(attempt.Sock), std::move(attempt.Owner), addresses[attempt.Address], false);
+		}
+		return opened;
+	}
+
+	size_t ConnectionPool::EvictIdle() noexcept
+	{
+		const auto now = std::chrono::steady_clock::now();
+		size_t evicted = 0;
+		for (size_t i = 0; i < SHARDS; i++)
+		{
+			Shard& shard = mShards[i];
+			const std::scoped_lock lock(shard.Mutex);
+			for (auto it = shard.Lists.begin(); it != shard.Lists.end();)
+			{
+				evicted += Expire(it->second, now);
+				it = it->second.Connections.empty() ? shard.Lists.erase(it) : std::next(it);
+			}
+		}
+		mEvicted.fetch_add(evicted, std::memory_order_relaxed);
+		return evicted;
+	}
+
+	size_t ConnectionPool::Idle(const SocketAddress& address) noexcept
+	{
+		const std::shared_ptr<Endpoint> endpoint = Find(address);
+		return endpoint ? endpoint->Idle.load(std::memory_order_relaxed) : 0;
+	}
+
+	size_t ConnectionPool::Total(const SocketAddress& address) noexcept
+	{
+		const std::shared_ptr<Endpoint> endpoint = Find(address);
+		return endpoint ? endpoint->Total.load(std::memory_order_relaxed) : 0;
+	}
+
+	size_t ConnectionPool::Endpoints() noexcept
+	{
+		size_t endpoints = 0;
+		for (size_t i = 0; i < SHARDS; i++)
+		{
+			const std::scoped_lock lock(mDirectories[i].Mutex);
+			endpoints += mDirectories[i].Endpoints.size();
+		}
+		return endpoints;
+	}
+
+	ConnectionPool::Stats ConnectionPool::GetStats() const noexcept
+	{
+		Stats stats;
+		stats.Hits = mHits.load(std::memory_order_relaxed);
+		stats.Misses = mMisses.load(std::memory_order_relaxed);
+		stats.Evicted = mEvicted.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	std::shared_ptr<ConnectionPool::Endpoint> ConnectionPool::Open(const SocketAddress& address) noexcept
+	{
+		Directory& directory = DirectoryOf(address);
+		const std::scoped_lock lock(directory.Mutex);
+		std::weak_ptr<Endpoint>& entry = directory.Endpoints[address];
+		if (std::shared_ptr<Endpoint> endpoint = entry.lock())
+			return endpoint;
+
+		//The last idle list or connection that lets go of it erases the entry, so refused addresses don't pile up
+		std::shared_ptr<Endpoint> endpoint(new Endpoint(), [this, address](const Endpoint* gone)
+		{
+			Forget(address);
+			delete gone;
+		});
+		entry = endpoint;
+		return endpoint;
+	}
+
+	std::shared_ptr<ConnectionPool::Endpoint> ConnectionPool::Find(const SocketAddress& address) noexcept
+	{
+		Directory& directory = DirectoryOf(address);
+		const std::scoped_lock lock(directory.Mutex);
+		const auto it = directory.Endpoints.find(address);
+		return it != directory.Endpoints.end() ? it->second.lock() : nullptr;
+	}
+
+	void ConnectionPool::Forget(const SocketAddress& address) noexcept
+	{
+		Directory& directory = DirectoryOf(address);
+		const std::scoped_lock lock(directory.Mutex);
+		const auto it = directory.Endpoints.find(address);
+		if (it != directory.Endpoints.end() && it->second.expired())//Open() might have replaced it already
+			directory.Endpoints.erase(it);
+	}
+
+	size_t ConnectionPool::Reserve(Endpoint& endpoint, const size_t wanted) const noexcept
+	{
+		size_t total = endpoint.Total.load(std::memory_order_relaxed);
+		size_t reserved;
+		do
+		{
+			reserved = std::min(wanted, mOptions.MaxTotal - std::min(mOptions.MaxTotal, total));
+			if (reserved == 0) return 0;
+		} while (!endpoint.Total.compare_exchange_weak(total, total + reserved, std::memory_order_relaxed));
+		return reserved;
+	}
+
+	bool ConnectionPool::Take(Shard& shard, const SocketAddress& address, Socket& sock, std::shared_ptr<Endpoint>& endpoint) noexcept
+	{
+		const std::scoped_lock lock(shard.Mutex);
+		const auto it = shard.Lists.find(address);
+		if (it == shard.Lists.end()) return false;
+
+		IdleList& list = it->second;
+		mEvicted.fetch_add(Expire(list, std::chrono::steady_clock::now()), std::memory_order_relaxed);
+		const bool taken = !list.Connections.empty();
+		if (taken)
+		{
+			sock = std::move(list.Connections.back().Sock);
+			list.Connections.pop_back();
+			endpoint = list.Owner;
+			endpoint->Idle.fetch_sub(1, std::memory_order_relaxed);
+		}
+		if (list.Connections.empty())
+			shard.Lists.erase(it);
+		return taken;
+	}
+
+	size_t ConnectionPool::Expire(IdleList& list, const std::chrono::steady_clock::time_point now) noexcept
+	{
+		const auto expired = std::find_if(list.Connections.begin(), list.Connections.end(), [this, now](const IdleConnection& idle) { return now - idle.Since < mOptions.IdleTimeout; });
+		const auto count = static_cast<size_t>(expired - list.Connections.begin());
+		list.Connections.erase(list.Connections.begin(), expired);
+		list.Owner->Idle.fetch_sub(count, std::memory_order_relaxed);
+		list.Owner->Total.fetch_sub(count, std::memory_order_relaxed);
+		return count;
+	}
+
+	void ConnectionPool::Return(Socket sock, std::shared_ptr<Endpoint> endpoint, const SocketAddress& address, const bool reusable) noexcept
+	{
+		if (reusable && sock.FileNo() != INVALID_SOCKET)
+		{
+			if (endpoint->Idle.fetch_add(1, std::memory_order_relaxed) < mOptions.MaxIdle)
+			{
+				//Into the shard of this thread, where its next lease looks first
+				Shard& shard = ShardOf(address, Stripe());
+				const std::scoped_lock lock(shard.Mutex);
+				IdleList& list = shard.Lists[address];
+				if (!list.Owner) list.Owner = endpoint;
+				list.Connections.push_back({ std::move(sock), std::chrono::steady_clock::now() });
+				return;
+			}
+			endpoint->Idle.fetch_sub(1, std::memory_order_relaxed);
+		}
+		endpoint->Total.fetch_sub(1, std::memory_order_relaxed);
+		//The connection is closed here, outside of the lock
+	}
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+//Threads are numbered in the order they first use a pool, the number picks their shard
+static size_t Stripe() noexcept
+{
+	static std::atomic<size_t> next = 0;
+	static thread_local const size_t stripe = next.fetch_add(1, std::memory_order_relaxed);
+	return stripe;
+}
+
+//Whether the outcome of a non-blocking connect is a connection
+static bool IsConnected(const socklib::SOCKET sock) noexcept
+{
+	int error = 0;
+	socklen_t size = sizeof(error);
+	return getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == 0 && error == 0;
+}
+
+#ifdef PLATFORM_WINDOWS
+	static std::error_code Exhausted() noexcept { return { WSAEWOULDBLOCK, std::system_category() }; }
+
+	//Idle connections have nothing to read, anything readable is an EOF, a reset or bytes nobody asked for
+	static bool IsHealthy(const socklib::Socket& sock) noexcept
+	{
+		pollfd fd = { sock.FileNo(), POLLIN, 0 };
+		return WSAPoll(&fd, 1, 0) == 0;
+	}
+#else//Unix like platforms
+	static std::error_code Exhausted() noexcept { return { EAGAIN, std::system_category() }; }
+
+	//Idle connections have nothing to read, anything readable is an EOF, a reset or bytes nobody asked for
+	static bool IsHealthy(const socklib::Socket& sock) noexcept
+	{
+		char byte;
+		ssize_t bytes;
+		do
+		{
+			bytes = recv(sock.FileNo(), &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+		} while (bytes == -1 && errno == EINTR);
+		return bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+	}
+#endif
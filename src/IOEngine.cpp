@@ -0,0 +1,544 @@
+#include <socklib/IOEngine.h>
+#ifdef PLATFORM_LINUX
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <atomic>
+	#include <cstring>
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+static int LastError() noexcept;
+static bool IsWouldBlock(int err) noexcept;
+static socklib::SOCKET AcceptCloseOnExec(socklib::SOCKET listener) noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+#ifdef PLATFORM_WINDOWS
+	constexpr int NO_WAIT_FLAGS = 0;//Readiness has already been reported, so the call won't block
+#else
+	constexpr int NO_WAIT_FLAGS = MSG_DONTWAIT | MSG_NOSIGNAL;
+#endif
+
+	void IOEngine::Accept(const Socket& listener, Handler handler) noexcept { Submit(OperationType::ACCEPT, listener, nullptr, 0, false, std::move(handler)); }
+
+	void IOEngine::AcceptMultishot(const Socket& listener, Handler handler) noexcept { Submit(OperationType::ACCEPT, listener, nullptr, 0, true, std::move(handler)); }
+
+	void IOEngine::Receive(const Socket& sock, void* data, const size_t length, Handler handler) noexcept { Submit(OperationType::RECEIVE, sock, data, length, false, std::move(handler)); }
+
+	void IOEngine::ReceiveMultishot(const Socket& sock, Handler handler) noexcept
+	{
+		SOCKLIB_ASSERT(mBufferCount > 0, "ProvideBuffers() must be called before ReceiveMultishot()!");
+		Submit(OperationType::RECEIVE, sock, nullptr, 0, true, std::move(handler));
+	}
+
+	void IOEngine::Send(const Socket& sock, const void* data, const size_t length, Handler handler) noexcept { Submit(OperationType::SEND, sock, const_cast<void*>(data), length, false, std::move(handler)); }
+
+	void IOEngine::Submit(const OperationType type, const Socket& sock, void* data, const size_t length, const bool multishot, Handler handler) noexcept
+	{
+		SOCKLIB_ASSERT(sock.FileNo() != INVALID_SOCKET, "The Socket is not opened!");
+		uint32_t id;
+		if (mFreeOperations.empty())
+		{
+			id = static_cast<uint32_t>(mOperations.size());
+			mOperations.emplace_back();
+		}
+		else
+		{
+			id = mFreeOperations.back();
+			mFreeOperations.pop_back();
+		}
+
+		Operation& operation = mOperations[id];
+		operation.Type = type;
+		operation.Multishot = multishot;
+		operation.Blocking = sock.IsBlocking();
+		operation.Family = sock.mAF;
+		operation.Sock = sock.FileNo();
+		operation.Data = data;
+		operation.Length = length;
+		operation.Callback = std::move(handler);
+
+		if (mRing)
+			Enqueue(id);
+		else
+			Wait(id);
+	}
+
+	void IOEngine::Complete(const uint32_t id, Completion& completion) noexcept
+	{
+		mDispatched++;
+		Operation& operation = mOperations[id];
+		if (completion.More)
+		{
+			operation.Callback(completion);
+			return;
+		}
+
+		//Release the slot first, so the handler is free to submit new operations
+		const Handler handler = std::move(operation.Callback);
+		operation = {};
+		mFreeOperations.push_back(id);
+		handler(completion);
+	}
+
+	Socket IOEngine::Adopt(const SOCKET sock, const AddressFamily family) noexcept
+	{
+		return { UniqueSocket(sock), family };
+	}
+
+	// ******************************
+	// | Fallback (readiness) engine |
+	// ******************************
+
+	void IOEngine::Wait(const uint32_t id) noexcept
+	{
+		const Operation& operation = mOperations[id];
+		Waiting& waiting = mWaiting[operation.Sock];
+		const bool registered = !waiting.Readers.empty() || !waiting.Writers.empty();
+		(operation.Type == OperationType::SEND ? waiting.Writers : waiting.Readers).push_back(id);
+
+		const PollEvent interest = (waiting.Readers.empty() ? PollEvent::NONE : PollEvent::READABLE) | (waiting.Writers.empty() ? PollEvent::NONE : PollEvent::WRITABLE);
+		if (registered)
+			mPoller.Modify(operation.Sock, interest);
+		else
+			mPoller.Add(operation.Sock, interest, [this](const SOCKET sock, const PollEvent events) { OnReady(sock, events); });
+	}
+
+	void IOEngine::OnReady(const SOCKET sock, const PollEvent events) noexcept
+	{
+		const bool failed = HasEvent(events, PollEvent::FAILURE | PollEvent::HANGUP);
+		for (const bool reading : { true, false })
+		{
+			if (!failed && !HasEvent(events, reading ? PollEvent::READABLE : PollEvent::WRITABLE)) continue;
+			while (true)
+			{
+				//Look it up every time, handlers may have submitted (or completed) operations
+				const auto it = mWaiting.find(sock);
+				if (it == mWaiting.end()) return;
+				Waiting& waiting = it->second;
+				std::deque<uint32_t>& queue = reading ? waiting.Readers : waiting.Writers;
+				if (queue.empty()) break;
+
+				const uint32_t id = queue.front();
+				const bool blocking = mOperations[id].Blocking;
+				Completion completion;
+				if (!Perform(id, completion)) break;//Would block
+
+				if (!completion.More)
+				{
+					//Unregister before invoking the handler, since it is allowed to close the socket
+					queue.pop_front();
+					if (waiting.Readers.empty() && waiting.Writers.empty())
+					{
+						mPoller.Remove(sock);
+						mWaiting.erase(it);
+					}
+					else
+						mPoller.Modify(sock, (waiting.Readers.empty() ? PollEvent::NONE : PollEvent::READABLE) | (waiting.Writers.empty() ? PollEvent::NONE : PollEvent::WRITABLE));
+				}
+				Complete(id, completion);
+				if (blocking) break;//Only one call is guaranteed not to block, wait for the next notification
+			}
+		}
+	}
+
+	bool IOEngine::Perform(const uint32_t id, Completion& completion) noexcept
+	{
+		const Operation& operation = mOperations[id];
+		switch (operation.Type)
+		{
+		case OperationType::ACCEPT:
+		{
+			const SOCKET client = AcceptCloseOnExec(operation.Sock);//The same flags io_uring accepts with
+			if (client == INVALID_SOCKET)
+			{
+				const int err = LastError();
+				if (IsWouldBlock(err)) return false;
+				completion.Result = -1;
+				completion.Error = err;
+			}
+			else
+				completion.Client = Adopt(client, operation.Family);
+			break;
+		}
+		case OperationType::RECEIVE:
+		{
+			char* buffer = static_cast<char*>(operation.Multishot ? mBuffers.data() : operation.Data);
+			const size_t length = operation.Multishot ? mBufferSize : operation.Length;
+			completion.Result = recv(operation.Sock, buffer, static_cast<int>(length), NO_WAIT_FLAGS);
+			if (completion.Result == -1)
+			{
+				const int err = LastError();
+				if (IsWouldBlock(err)) return false;
+				completion.Error = err;
+			}
+			else if (operation.Multishot)
+				completion.Data = reinterpret_cast<const BYTE*>(buffer);
+			break;
+		}
+		case OperationType::SEND:
+		{
+			completion.Result = send(operation.Sock, static_cast<const char*>(operation.Data), static_cast<int>(operation.Length), NO_WAIT_FLAGS);
+			if (completion.Result == -1)
+			{
+				const int err = LastError();
+				if (IsWouldBlock(err)) return false;
+				completion.Error = err;
+			}
+			break;
+		}
+		}
+
+		//Multishot operations end on error and on end of stream
+		completion.More = operation.Multishot && completion.Result != -1 && !(operation.Type == OperationType::RECEIVE && completion.Result == 0);
+		return true;
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_LINUX
+
+	struct IOEngine::Ring {
+		int Fd = -1;
+
+		//Submission queue
+		void* SqRing = MAP_FAILED;
+		size_t SqRingSize = 0;
+		io_uring_sqe* Sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+		size_t SqesSize = 0;
+		uint32_t* SqHead = nullptr;
+		uint32_t* SqTail = nullptr;
+		uint32_t* SqArray = nullptr;
+		uint32_t* SqFlags = nullptr;
+		uint32_t SqMask = 0;
+		uint32_t SqEntries = 0;
+		uint32_t LocalTail = 0;
+		uint32_t ToSubmit = 0;
+
+		//Completion queue
+		void* CqRing = MAP_FAILED;
+		size_t CqRingSize = 0;
+		io_uring_cqe* Cqes = nullptr;
+		uint32_t* CqHead = nullptr;
+		uint32_t* CqTail = nullptr;
+		uint32_t CqMask = 0;
+
+		//Provided buffers ring
+		io_uring_buf_ring* Buffers = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+		size_t BuffersSize = 0;
+		uint16_t BufferTail = 0;
+		uint16_t BufferMask = 0;
+
+		~Ring() noexcept
+		{
+			if (Buffers != MAP_FAILED) munmap(Buffers, BuffersSize);
+			if (Sqes != MAP_FAILED) munmap(Sqes, SqesSize);
+			if (CqRing != MAP_FAILED && CqRing != SqRing) munmap(CqRing, CqRingSize);
+			if (SqRing != MAP_FAILED) munmap(SqRing, SqRingSize);
+			if (Fd != -1) close(Fd);
+		}
+	};
+
+	IOEngine::IOEngine(const uint32_t entries, const bool useIOUring) noexcept
+	{
+		if (!useIOUring) return;
+
+		io_uring_params params{};
+		params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+		int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		if (fd == -1 && errno == EINVAL)//Kernel doesn't know about the flags, try without them
+		{
+			params = {};
+			fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		}
+		if (fd == -1) return;//No io_uring (ENOSYS, EPERM etc.), use the fallback engine
+
+		auto ring = std::make_unique<Ring>();
+		ring->Fd = fd;
+		if (!(params.features & IORING_FEAT_EXT_ARG)) return;//Can't wait with a timeout (< 5.11)
+
+		ring->SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		ring->CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (single)
+			ring->SqRingSize = ring->CqRingSize = std::max(ring->SqRingSize, ring->CqRingSize);
+
+		ring->SqRing = mmap(nullptr, ring->SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (ring->SqRing == MAP_FAILED) return;
+		ring->CqRing = single ? ring->SqRing : mmap(nullptr, ring->CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (ring->CqRing == MAP_FAILED) return;
+		ring->SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		ring->Sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+		if (ring->Sqes == MAP_FAILED) return;
+
+		auto* sq = static_cast<BYTE*>(ring->SqRing);
+		ring->SqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+		ring->SqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+		ring->SqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+		ring->SqFlags = reinterpret_cast<uint32_t*>(sq + params.sq_off.flags);
+		ring->SqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+		ring->SqEntries = params.sq_entries;
+		ring->LocalTail = *ring->SqTail;
+
+		auto* cq = static_cast<BYTE*>(ring->CqRing);
+		ring->CqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+		ring->CqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+		ring->CqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+		ring->Cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+		mRing = std::move(ring);
+	}
+
+	IOEngine::~IOEngine() noexcept { mRing.reset(); }//Close the ring before its buffers are released
+
+	bool IOEngine::ProvideBuffers(const uint32_t count, const size_t size) noexcept
+	{
+		SOCKLIB_ASSERT(mBufferCount == 0, "Buffers have already been provided!");
+		SOCKLIB_ASSERT(count > 0 && count <= 32768 && (count & (count - 1)) == 0, "Buffer count must be a power of two (up to 32768)!");
+		if (mRing)
+		{
+			Ring& ring = *mRing;
+			ring.BuffersSize = count * sizeof(io_uring_buf);
+			ring.Buffers = static_cast<io_uring_buf_ring*>(mmap(nullptr, ring.BuffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+			io_uring_buf_reg reg{};
+			reg.ring_addr = reinterpret_cast<uint64_t>(ring.Buffers);
+			reg.ring_entries = count;
+			reg.bgid = 0;
+			const long result = ring.Buffers == MAP_FAILED ? -1 : syscall(__NR_io_uring_register, ring.Fd, IORING_REGISTER_PBUF_RING, &reg, 1);
+			if (result == -1)
+			{
+				//Kernel is too old for provided buffer rings (< 5.19) or we are out of memory
+				if (ring.Buffers != MAP_FAILED) munmap(ring.Buffers, ring.BuffersSize);
+				ring.Buffers = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+				if (Pending() > 0) return false;//Operations already live in the ring, we can't move them to the fallback engine
+				mRing.reset();
+			}
+		}
+
+		mBufferCount = count;
+		mBufferSize = size;
+		mBuffers.resize(count * size);
+		if (!mRing) return true;
+
+		mRing->BufferMask = static_cast<uint16_t>(count - 1);
+		for (uint32_t bid = 0; bid < count; bid++)
+			RecycleBuffer(static_cast<uint16_t>(bid));
+		return true;
+	}
+
+	void IOEngine::RecycleBuffer(const uint16_t bid) noexcept
+	{
+		Ring& ring = *mRing;
+		io_uring_buf& buffer = reinterpret_cast<io_uring_buf*>(ring.Buffers)[ring.BufferTail & ring.BufferMask];
+		buffer.addr = reinterpret_cast<uint64_t>(mBuffers.data() + bid * mBufferSize);
+		buffer.len = static_cast<uint32_t>(mBufferSize);
+		buffer.bid = bid;
+		ring.BufferTail++;
+		std::atomic_ref(ring.Buffers->tail).store(ring.BufferTail, std::memory_order_release);
+	}
+
+	void IOEngine::Enqueue(const uint32_t id) noexcept
+	{
+		Ring& ring = *mRing;
+		if (ring.LocalTail - std::atomic_ref(*ring.SqHead).load(std::memory_order_acquire) == ring.SqEntries)
+		{
+			//Submission queue is full, hand what we have over to the kernel
+			const long submitted = syscall(__NR_io_uring_enter, ring.Fd, ring.ToSubmit, 0, 0, nullptr, 0);
+			SOCKLIB_ASSERT(submitted != -1, GetError().c_str());
+			if (submitted > 0) ring.ToSubmit -= static_cast<uint32_t>(submitted);
+		}
+
+		const Operation& operation = mOperations[id];
+		const uint32_t index = ring.LocalTail & ring.SqMask;
+		io_uring_sqe& sqe = ring.Sqes[index];
+		memset(&sqe, 0, sizeof(io_uring_sqe));
+		sqe.fd = operation.Sock;
+		sqe.user_data = id;
+		switch (operation.Type)
+		{
+		case OperationType::ACCEPT:
+			sqe.opcode = IORING_OP_ACCEPT;
+			sqe.accept_flags = SOCK_CLOEXEC;
+			if (operation.Multishot) sqe.ioprio |= IORING_ACCEPT_MULTISHOT;
+			break;
+		case OperationType::RECEIVE:
+			sqe.opcode = IORING_OP_RECV;
+			if (operation.Multishot)
+			{
+				sqe.ioprio |= IORING_RECV_MULTISHOT;
+				sqe.flags |= IOSQE_BUFFER_SELECT;
+				sqe.buf_group = 0;
+			}
+			else
+			{
+				sqe.addr = reinterpret_cast<uint64_t>(operation.Data);
+				sqe.len = static_cast<uint32_t>(operation.Length);
+			}
+			break;
+		case OperationType::SEND:
+			sqe.opcode = IORING_OP_SEND;
+			sqe.addr = reinterpret_cast<uint64_t>(operation.Data);
+			sqe.len = static_cast<uint32_t>(operation.Length);
+			sqe.msg_flags = MSG_NOSIGNAL;
+			break;
+		}
+
+		ring.SqArray[index] = index;
+		ring.LocalTail++;
+		ring.ToSubmit++;
+		std::atomic_ref(*ring.SqTail).store(ring.LocalTail, std::memory_order_release);
+	}
+
+	size_t IOEngine::Reap() noexcept
+	{
+		Ring& ring = *mRing;
+		size_t reaped = 0;
+		uint32_t head = *ring.CqHead;
+		while (true)
+		{
+			if (head == std::atomic_ref(*ring.CqTail).load(std::memory_order_acquire))
+			{
+				//Completions that didn't fit in the queue are kept by the kernel until we ask for them
+				if (!(std::atomic_ref(*ring.SqFlags).load(std::memory_order_acquire) & IORING_SQ_CQ_OVERFLOW)) break;
+				const long result = syscall(__NR_io_uring_enter, ring.Fd, 0, 0, IORING_ENTER_GETEVENTS, nullptr, 0);
+				SOCKLIB_ASSERT(result != -1 || errno == EINTR || errno == EBUSY, GetError().c_str());
+				if (head == std::atomic_ref(*ring.CqTail).load(std::memory_order_acquire)) break;//Nothing was flushed
+				continue;
+			}
+
+			//Copy and release the slot before invoking anything
+			const io_uring_cqe cqe = ring.Cqes[head & ring.CqMask];
+			std::atomic_ref(*ring.CqHead).store(++head, std::memory_order_release);
+
+			const auto id = static_cast<uint32_t>(cqe.user_data);
+			const Operation& operation = mOperations[id];
+			Completion completion;
+			completion.More = operation.Multishot && (cqe.flags & IORING_CQE_F_MORE);
+
+			const bool buffered = cqe.flags & IORING_CQE_F_BUFFER;
+			const auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+			if (cqe.res < 0)
+			{
+				completion.Result = -1;
+				completion.Error = -cqe.res;
+			}
+			else if (operation.Type == OperationType::ACCEPT)
+				completion.Client = Adopt(cqe.res, operation.Family);
+			else
+			{
+				completion.Result = cqe.res;
+				if (buffered) completion.Data = mBuffers.data() + bid * mBufferSize;
+			}
+
+			Complete(id, completion);
+			if (buffered) RecycleBuffer(bid);
+			reaped++;
+		}
+		return reaped;
+	}
+
+	size_t IOEngine::Poll(const int32_t millis) noexcept
+	{
+		const size_t before = mDispatched;
+		if (!mRing)
+		{
+			mPoller.Poll(millis);
+			return mDispatched - before;
+		}
+
+		Ring& ring = *mRing;
+		const bool ready = Reap() > 0;
+
+		__kernel_timespec timeout{};
+		io_uring_getevents_arg arg{};
+		if (millis >= 0)
+		{
+			timeout.tv_sec = millis / 1000;
+			timeout.tv_nsec = (millis % 1000) * 1000000LL;
+			arg.ts = reinterpret_cast<uint64_t>(&timeout);
+		}
+
+		//Always enter, completions might be waiting for us to run task work
+		const uint32_t wait = (ready || millis == 0) ? 0 : 1;
+		const long result = syscall(__NR_io_uring_enter, ring.Fd, ring.ToSubmit, wait, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+		if (result >= 0)
+			ring.ToSubmit -= static_cast<uint32_t>(std::min<long>(result, ring.ToSubmit));
+		SOCKLIB_ASSERT(result != -1 || errno == ETIME || errno == EINTR || errno == EBUSY, GetError().c_str());
+
+		Reap();
+		return mDispatched - before;
+	}
+
+#else//Platforms without io_uring
+
+	struct IOEngine::Ring {};
+
+	IOEngine::IOEngine(uint32_t, bool) noexcept {}
+
+	IOEngine::~IOEngine() noexcept = default;
+
+	bool IOEngine::ProvideBuffers(const uint32_t count, const size_t size) noexcept
+	{
+		SOCKLIB_ASSERT(mBufferCount == 0, "Buffers have already been provided!");
+		mBufferCount = count;
+		mBufferSize = size;
+		mBuffers.resize(size);//Only one receive is performed at a time
+		return true;
+	}
+
+	void IOEngine::RecycleBuffer(uint16_t) noexcept {}
+
+	void IOEngine::Enqueue(uint32_t) noexcept {}
+
+	size_t IOEngine::Reap() noexcept { return 0; }
+
+	size_t IOEngine::Poll(const int32_t millis) noexcept
+	{
+		const size_t before = mDispatched;
+		mPoller.Poll(millis);
+		return mDispatched - before;
+	}
+
+#endif
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+#ifdef PLATFORM_WINDOWS
+	static int LastError() noexcept { return WSAGetLastError(); }
+
+	static bool IsWouldBlock(const int err) noexcept { return err == WSAEWOULDBLOCK; }
+
+	static socklib::SOCKET AcceptCloseOnExec(const socklib::SOCKET listener) noexcept { return accept(listener, nullptr, nullptr); }//Windows has no exec(), so there is no flag to match
+#else//Unix like platforms
+	static int LastError() noexcept { return errno; }
+
+	static bool IsWouldBlock(const int err) noexcept { return err == EAGAIN || err == EWOULDBLOCK; }
+
+	static socklib::SOCKET AcceptCloseOnExec(const socklib::SOCKET listener) noexcept
+	{
+	#ifdef SOCK_CLOEXEC
+		return accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+	#else
+		const socklib::SOCKET sock = accept(listener, nullptr, nullptr);
+		if (sock == INVALID_SOCKET) return sock;
+		if (fcntl(sock, F_SETFD, FD_CLOEXEC) == -1)
+		{
+			const int error = errno;
+			close(sock);
+			errno = error;
+			return INVALID_SOCKET;
+		}
+		return sock;
+	#endif
+	}
+#endif
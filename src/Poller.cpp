@@ -0,0 +1,281 @@
+#include <socklib/Poller.h>
+#ifdef PLATFORM_LINUX
+	#include <sys/eventfd.h>
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	void Poller::Run() noexcept
+	{
+		while (!mStopRequested.exchange(false))
+		{
+		#ifdef PLATFORM_WINDOWS
+			Poll(50);//WSAPoll() can't be interrupted, so we have to check for Stop() every now and then
+		#else
+			Poll();
+		#endif
+		}
+	}
+
+	void Poller::Stop() noexcept
+	{
+		mStopRequested = true;
+		Wakeup();
+	}
+
+	bool Poller::Dispatch(const SOCKET sock, const PollEvent events, const uint64_t generation) noexcept
+	{
+		const auto it = mEntries.find(sock);
+		if (it == mEntries.end()) return false;//Removed by a previous callback
+		Entry* entry = it->second.get();
+		if (entry->Generation > generation) return false;//Closed and re-added by a previous callback, the events belong to the old one
+		entry->Handler(sock, events);
+		return true;
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_LINUX
+
+	static uint32_t ToNative(const PollEvent interest) noexcept
+	{
+		uint32_t events = 0;
+		if (HasEvent(interest, PollEvent::READABLE)) events |= EPOLLIN;
+		if (HasEvent(interest, PollEvent::WRITABLE)) events |= EPOLLOUT;
+		return events;
+	}
+
+	static PollEvent FromNative(const uint32_t events) noexcept
+	{
+		PollEvent result = PollEvent::NONE;
+		if (events & EPOLLIN) result = result | PollEvent::READABLE;
+		if (events & EPOLLOUT) result = result | PollEvent::WRITABLE;
+		if (events & EPOLLERR) result = result | PollEvent::FAILURE;
+		if (events & EPOLLHUP) result = result | PollEvent::HANGUP;
+		return result;
+	}
+
+	Poller::Poller() noexcept
+		: mEvents(256)
+	{
+		mEpoll = epoll_create1(EPOLL_CLOEXEC);
+		SOCKLIB_ASSERT(mEpoll != -1, GetError().c_str());
+		mWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		SOCKLIB_ASSERT(mWakeFd != -1, GetError().c_str());
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.fd = mWakeFd;
+		const int result = epoll_ctl(mEpoll, EPOLL_CTL_ADD, mWakeFd, &event);
+		SOCKLIB_ASSERT(result != -1, GetError().c_str());
+	}
+
+	Poller::~Poller() noexcept
+	{
+		close(mWakeFd);
+		close(mEpoll);
+	}
+
+	void Poller::Add(const SOCKET sock, const PollEvent interest, Callback callback) noexcept
+	{
+		SOCKLIB_ASSERT(sock != INVALID_SOCKET, "The Socket is not opened!");
+		SOCKLIB_ASSERT(!Contains(sock), "The Socket is already registered!");
+		epoll_event event{};
+		event.events = ToNative(interest);
+		event.data.fd = sock;
+		const int result = epoll_ctl(mEpoll, EPOLL_CTL_ADD, sock, &event);
+		SOCKLIB_ASSERT(result != -1, GetError().c_str());
+		mEntries.emplace(sock, std::make_unique<Entry>(Entry{ interest, std::move(callback), ++mGeneration }));
+	}
+
+	void Poller::Modify(const SOCKET sock, const PollEvent interest) noexcept
+	{
+		const auto it = mEntries.find(sock);
+		SOCKLIB_ASSERT(it != mEntries.end(), "The Socket is not registered!");
+		if (it->second->Interest == interest) return;
+		epoll_event event{};
+		event.events = ToNative(interest);
+		event.data.fd = sock;
+		const int result = epoll_ctl(mEpoll, EPOLL_CTL_MOD, sock, &event);
+		SOCKLIB_ASSERT(result != -1, GetError().c_str());
+		it->second->Interest = interest;
+	}
+
+	void Poller::Remove(const SOCKET sock) noexcept
+	{
+		const auto it = mEntries.find(sock);
+		SOCKLIB_ASSERT(it != mEntries.end(), "The Socket is not registered!");
+		if (it == mEntries.end()) return;
+		//A closed descriptor already left the epoll set (EBADF), or its number now belongs to another file (ENOENT)
+		const int result = epoll_ctl(mEpoll, EPOLL_CTL_DEL, sock, nullptr);
+		SOCKLIB_ASSERT(result != -1 || errno == EBADF || errno == ENOENT, GetError().c_str());
+		if (mDispatching)
+			mRetired.emplace_back(std::move(it->second));
+		mEntries.erase(it);
+	}
+
+	size_t Poller::Poll(const int32_t millis) noexcept
+	{
+		const int count = epoll_wait(mEpoll, mEvents.data(), static_cast<int>(mEvents.size()), millis);
+		if (count == -1 && errno == EINTR) return 0;
+		SOCKLIB_ASSERT(count != -1, GetError().c_str());
+
+		size_t dispatched = 0;
+		const uint64_t generation = mGeneration;
+		mDispatching = true;
+		for (int i = 0; i < count; i++)
+		{
+			const epoll_event& event = mEvents[i];
+			if (event.data.fd == mWakeFd)
+			{
+				eventfd_t value;
+				eventfd_read(mWakeFd, &value);
+				continue;
+			}
+			if (Dispatch(event.data.fd, FromNative(event.events), generation))
+				dispatched++;
+		}
+		mDispatching = false;
+		mRetired.clear();
+
+		if (static_cast<size_t>(count) == mEvents.size())//Let the next call harvest more events at once
+			mEvents.resize(mEvents.size() * 2);
+		return dispatched;
+	}
+
+	void Poller::Wakeup() const noexcept { eventfd_write(mWakeFd, 1); }
+
+#else//Platforms without epoll
+
+	static short ToNative(const PollEvent interest) noexcept
+	{
+		short events = 0;
+		if (HasEvent(interest, PollEvent::READABLE)) events |= POLLIN;
+		if (HasEvent(interest, PollEvent::WRITABLE)) events |= POLLOUT;
+		return events;
+	}
+
+	static PollEvent FromNative(const short events) noexcept
+	{
+		PollEvent result = PollEvent::NONE;
+		if (events & POLLIN) result = result | PollEvent::READABLE;
+		if (events & POLLOUT) result = result | PollEvent::WRITABLE;
+		if (events & (POLLERR | POLLNVAL)) result = result | PollEvent::FAILURE;
+		if (events & POLLHUP) result = result | PollEvent::HANGUP;
+		return result;
+	}
+
+	Poller::Poller() noexcept
+	{
+	#ifndef PLATFORM_WINDOWS
+		const int result = pipe(mWakePipe);
+		SOCKLIB_ASSERT(result != -1, GetError().c_str());
+		for (const int fd : mWakePipe)
+		{
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			fcntl(fd, F_SETFD, FD_CLOEXEC);
+		}
+		mPollFds.push_back({ mWakePipe[0], POLLIN, 0 });
+	#endif
+	}
+
+	Poller::~Poller() noexcept
+	{
+	#ifndef PLATFORM_WINDOWS
+		close(mWakePipe[0]);
+		close(mWakePipe[1]);
+	#endif
+	}
+
+	void Poller::Add(const SOCKET sock, const PollEvent interest, Callback callback) noexcept
+	{
+		SOCKLIB_ASSERT(sock != INVALID_SOCKET, "The Socket is not opened!");
+		SOCKLIB_ASSERT(!Contains(sock), "The Socket is already registered!");
+		mIndices.emplace(sock, mPollFds.size());
+		mPollFds.push_back({ sock, ToNative(interest), 0 });
+		mEntries.emplace(sock, std::make_unique<Entry>(Entry{ interest, std::move(callback), ++mGeneration }));
+	}
+
+	void Poller::Modify(const SOCKET sock, const PollEvent interest) noexcept
+	{
+		const auto it = mEntries.find(sock);
+		SOCKLIB_ASSERT(it != mEntries.end(), "The Socket is not registered!");
+		mPollFds[mIndices[sock]].events = ToNative(interest);
+		it->second->Interest = interest;
+	}
+
+	void Poller::Remove(const SOCKET sock) noexcept
+	{
+		const auto it = mEntries.find(sock);
+		SOCKLIB_ASSERT(it != mEntries.end(), "The Socket is not registered!");
+		if (it == mEntries.end()) return;
+
+		//Swap with the last one so removal doesn't need to shift the array
+		const size_t index = mIndices[sock];
+		mPollFds[index] = mPollFds.back();
+		mIndices[mPollFds[index].fd] = index;
+		mPollFds.pop_back();
+		mIndices.erase(sock);
+
+		if (mDispatching)
+			mRetired.emplace_back(std::move(it->second));
+		mEntries.erase(it);
+	}
+
+	size_t Poller::Poll(const int32_t millis) noexcept
+	{
+	#ifdef PLATFORM_WINDOWS
+		if (mPollFds.empty()) return 0;//WSAPoll() fails without any sockets
+		const int count = WSAPoll(mPollFds.data(), static_cast<ULONG>(mPollFds.size()), millis);
+	#else
+		const int count = poll(mPollFds.data(), static_cast<nfds_t>(mPollFds.size()), millis);
+		if (count == -1 && errno == EINTR) return 0;
+	#endif
+		SOCKLIB_ASSERT(count != SOCKET_ERROR, GetError().c_str());
+
+		//Collect first since callbacks are allowed to modify the array
+		mReady.clear();
+		for (const pollfd& fd : mPollFds)
+		{
+			if (fd.revents == 0) continue;
+		#ifndef PLATFORM_WINDOWS
+			if (fd.fd == mWakePipe[0])
+			{
+				char buffer[64];
+				while (read(mWakePipe[0], buffer, sizeof(buffer)) > 0);
+				continue;
+			}
+		#endif
+			mReady.emplace_back(fd.fd, FromNative(fd.revents));
+		}
+
+		size_t dispatched = 0;
+		const uint64_t generation = mGeneration;
+		mDispatching = true;
+		for (const auto& [sock, events] : mReady)
+		{
+			if (Dispatch(sock, events, generation))
+				dispatched++;
+		}
+		mDispatching = false;
+		mRetired.clear();
+		return dispatched;
+	}
+
+	void Poller::Wakeup() const noexcept
+	{
+	#ifndef PLATFORM_WINDOWS
+		constexpr char byte = 0;
+		[[maybe_unused]] const ssize_t result = write(mWakePipe[1], &byte, 1);
+	#endif
+	}
+
+#endif
+
+}
@@ -0,0 +1,274 @@
+#include <socklib/Relay.h>
+#include <cstring>
+
+//Declaration of helper functions
+static std::error_code PendingError(const socklib::Socket& sock) noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	//Bound on the rounds spent on a direction per event, so a fast sender can't starve the rest of the Poller
+	static constexpr size_t MAX_ROUNDS = 16;
+
+	Relay::Relay(Poller& poller, Socket first, Socket second, Callback done) noexcept
+		: mPoller(poller), mFirst(std::move(first)), mSecond(std::move(second)), mDone(std::move(done))
+	{
+		SOCKLIB_ASSERT(mFirst.FileNo() != INVALID_SOCKET && mSecond.FileNo() != INVALID_SOCKET, "Both Sockets must be opened!");
+		mFirst.SetBlocking(false);
+		mSecond.SetBlocking(false);
+
+		mForward.From = &mFirst;
+		mForward.To = &mSecond;
+		mBackward.From = &mSecond;
+		mBackward.To = &mFirst;
+
+		Result<void> opened = Open(mForward);
+		if (opened)
+			opened = Open(mBackward);
+		if (!opened)
+		{
+			mError = opened.error();
+			Release(mForward);
+			Release(mBackward);
+			mFinished = true;
+			return;
+		}
+
+		mFirstInterest = PollEvent::READABLE;
+		mSecondInterest = PollEvent::READABLE;
+		mPoller.Add(mFirst, mFirstInterest, [this](SOCKET, const PollEvent events) { OnEvent(mFirst, events); });
+		mPoller.Add(mSecond, mSecondInterest, [this](SOCKET, const PollEvent events) { OnEvent(mSecond, events); });
+	}
+
+	Relay::~Relay() noexcept { Close(); }
+
+	void Relay::Close() noexcept
+	{
+		if (mFinished) return;
+		Unregister();
+		Release(mForward);
+		Release(mBackward);
+		mFinished = true;
+	}
+
+	void Relay::OnEvent(const Socket& sock, const PollEvent events) noexcept
+	{
+		if (HasEvent(events, PollEvent::FAILURE))
+		{
+			mError = PendingError(sock);
+			Finish();
+			return;
+		}
+
+		if (!Pump(mForward) || !Pump(mBackward) || (mForward.ShutDown && mBackward.ShutDown))
+		{
+			Finish();
+			return;
+		}
+		Watch();
+	}
+
+	bool Relay::Pump(Direction& direction) noexcept
+	{
+		for (size_t round = 0; round < MAX_ROUNDS; round++)
+		{
+			bool progress = false;
+			if (!direction.EndOfStream && direction.Buffered < direction.Capacity)
+			{
+				const Result<size_t> bytes = Fill(direction);
+				if (bytes)
+				{
+					direction.EndOfStream = *bytes == 0;
+					progress = *bytes > 0;
+				}
+				else if (!WouldBlock(bytes.error()))
+				{
+					mError = bytes.error();
+					return false;
+				}
+			}
+
+			if (direction.Buffered > 0)
+			{
+				const Result<size_t> bytes = Drain(direction);
+				if (bytes)
+					progress |= *bytes > 0;
+				else if (!WouldBlock(bytes.error()))
+				{
+					mError = bytes.error();
+					return false;
+				}
+			}
+
+			if (!progress) break;
+		}
+
+		//Everything the sender wrote before shutting down has been forwarded, pass the shutdown along
+		if (direction.EndOfStream && direction.Buffered == 0 && !direction.ShutDown)
+		{
+			(void)direction.To->TryShutdown(SHUT_WR);//The peer may be gone already, which is fine at this point
+			direction.ShutDown = true;
+		}
+		return true;
+	}
+
+	void Relay::Watch() noexcept
+	{
+		auto interest = [](const Direction& inbound, const Direction& outbound)
+		{
+			PollEvent events = PollEvent::NONE;
+			if (!inbound.EndOfStream && inbound.Buffered < inbound.Capacity) events = events | PollEvent::READABLE;
+			if (outbound.Buffered > 0) events = events | PollEvent::WRITABLE;
+			return events;
+		};
+
+		const PollEvent first = interest(mForward, mBackward);
+		if (first != mFirstInterest)
+		{
+			mPoller.Modify(mFirst, first);
+			mFirstInterest = first;
+		}
+
+		const PollEvent second = interest(mBackward, mForward);
+		if (second != mSecondInterest)
+		{
+			mPoller.Modify(mSecond, second);
+			mSecondInterest = second;
+		}
+	}
+
+	void Relay::Finish() noexcept
+	{
+		Close();
+		Callback done = std::move(mDone);//The callback may destroy us, so nothing can be touched after it
+		if (done)
+			done(*this);
+	}
+
+	void Relay::Unregister() noexcept
+	{
+		if (mPoller.Contains(mFirst.FileNo()))
+			mPoller.Remove(mFirst);
+		if (mPoller.Contains(mSecond.FileNo()))
+			mPoller.Remove(mSecond);
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_LINUX
+	static constexpr int PIPE_SIZE = 256 * KiB;
+
+	Result<void> Relay::Open(Direction& direction) noexcept
+	{
+		if (pipe2(direction.Pipe, O_CLOEXEC | O_NONBLOCK) == -1)
+			return Unexpected(std::error_code(errno, std::system_category()));
+		fcntl(direction.Pipe[1], F_SETPIPE_SZ, PIPE_SIZE);//Fewer system calls per byte if allowed, the default is 64 KiB
+		const int capacity = fcntl(direction.Pipe[1], F_GETPIPE_SZ);
+		direction.Capacity = capacity > 0 ? static_cast<size_t>(capacity) : 64 * KiB;
+		return {};
+	}
+
+	void Relay::Release(Direction& direction) noexcept
+	{
+		if (direction.Pipe[0] == -1) return;
+		close(direction.Pipe[0]);
+		close(direction.Pipe[1]);
+		direction.Pipe[0] = direction.Pipe[1] = -1;
+		direction.Buffered = 0;
+	}
+
+	Result<size_t> Relay::Fill(Direction& direction) noexcept
+	{
+		while (true)
+		{
+			const ssize_t bytes = splice(direction.From->FileNo(), nullptr, direction.Pipe[1], nullptr, direction.Capacity - direction.Buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			if (bytes != -1)
+			{
+				direction.Buffered += static_cast<size_t>(bytes);
+				return static_cast<size_t>(bytes);
+			}
+			if (errno != EINTR)
+				return Unexpected(std::error_code(errno, std::system_category()));
+		}
+	}
+
+	Result<size_t> Relay::Drain(Direction& direction) noexcept
+	{
+		while (true)
+		{
+			const ssize_t bytes = splice(direction.Pipe[0], nullptr, direction.To->FileNo(), nullptr, direction.Buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			if (bytes != -1)
+			{
+				direction.Buffered -= static_cast<size_t>(bytes);
+				direction.Bytes += static_cast<uint64_t>(bytes);
+				return static_cast<size_t>(bytes);
+			}
+			if (errno != EINTR)
+				return Unexpected(std::error_code(errno, std::system_category()));
+		}
+	}
+#else
+	static constexpr size_t BUFFER_SIZE = 64 * KiB;
+
+	Result<void> Relay::Open(Direction& direction) noexcept
+	{
+		direction.Buffer = BufferPool::Acquire(BUFFER_SIZE);
+		if (!direction.Buffer.IsValid())
+			return Unexpected(std::make_error_code(std::errc::not_enough_memory));
+		direction.Capacity = BUFFER_SIZE;
+		return {};
+	}
+
+	void Relay::Release(Direction& direction) noexcept
+	{
+		direction.Buffer.Reset();
+		direction.Buffered = 0;
+		direction.Start = 0;
+	}
+
+	Result<size_t> Relay::Fill(Direction& direction) noexcept
+	{
+		//Move the unsent bytes to the front so the free space is contiguous
+		if (direction.Start > 0)
+		{
+			memmove(direction.Buffer.Data(), direction.Buffer.Data() + direction.Start, direction.Buffered);
+			direction.Start = 0;
+		}
+
+		const Result<size_t> bytes = direction.From->TryReceive(direction.Buffer.Data(), direction.Capacity - direction.Buffered, direction.Buffered);
+		if (bytes)
+			direction.Buffered += *bytes;
+		return bytes;
+	}
+
+	Result<size_t> Relay::Drain(Direction& direction) noexcept
+	{
+		const Result<size_t> bytes = direction.To->TrySend(direction.Buffer.Data(), direction.Buffered, direction.Start);
+		if (bytes)
+		{
+			direction.Start += *bytes;
+			direction.Buffered -= *bytes;
+			direction.Bytes += *bytes;
+			if (direction.Buffered == 0)
+				direction.Start = 0;
+		}
+		return bytes;
+	}
+#endif
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+static std::error_code PendingError(const socklib::Socket& sock) noexcept
+{
+	int error = 0;
+	socklen_t size = sizeof(int);
+	getsockopt(sock.FileNo(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size);
+	if (error == 0) return std::make_error_code(std::errc::connection_reset);//Reported as failed, but the error was already consumed
+	return { error, std::system_category() };
+}
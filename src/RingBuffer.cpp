@@ -0,0 +1,179 @@
+#include <socklib/RingBuffer.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#ifndef PLATFORM_WINDOWS
+	#include <sys/mman.h>
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	RingBuffer::RingBuffer(RingBuffer&& other) noexcept
+		: mData(std::exchange(other.mData, nullptr)), mCapacity(std::exchange(other.mCapacity, 0)),
+		mRead(std::exchange(other.mRead, 0)), mSize(std::exchange(other.mSize, 0)) {}
+
+	RingBuffer::~RingBuffer() noexcept { Unmap(); }
+
+	RingBuffer& RingBuffer::operator=(RingBuffer&& rhs) noexcept
+	{
+		if (this == &rhs) return *this;
+		Unmap();
+		mData = std::exchange(rhs.mData, nullptr);
+		mCapacity = std::exchange(rhs.mCapacity, 0);
+		mRead = std::exchange(rhs.mRead, 0);
+		mSize = std::exchange(rhs.mSize, 0);
+		return *this;
+	}
+
+	void RingBuffer::Commit(const size_t bytes) noexcept
+	{
+		SOCKLIB_ASSERT(bytes <= Free(), "Committed more bytes than the free space!");
+		mSize += bytes;
+	}
+
+	void RingBuffer::Consume(const size_t bytes) noexcept
+	{
+		SOCKLIB_ASSERT(bytes <= mSize, "Consumed more bytes than the readable ones!");
+		mSize -= bytes;
+		mRead += bytes;
+		if (mRead >= mCapacity)
+			mRead -= mCapacity;
+		if (mSize == 0)
+			mRead = 0;//Keeps the next frames away from the wrap point for as long as possible
+	}
+
+	size_t RingBuffer::Write(const void* data, const size_t length) noexcept
+	{
+		const size_t bytes = std::min(length, Free());
+		memcpy(Writable().data(), data, bytes);
+		Commit(bytes);
+		return bytes;
+	}
+
+	size_t RingBuffer::Read(void* data, const size_t length) noexcept
+	{
+		const size_t bytes = std::min(length, mSize);
+		memcpy(data, Readable().data(), bytes);
+		Consume(bytes);
+		return bytes;
+	}
+
+	Result<size_t> RingBuffer::Receive(const Socket& sock) noexcept
+	{
+		SOCKLIB_ASSERT(IsValid(), "The RingBuffer is not mapped!");
+		if (Full()) return 0;
+		const std::span<BYTE> space = Writable();
+		const Result<size_t> bytes = sock.TryReceive(space.data(), space.size());
+		if (bytes)
+			Commit(*bytes);
+		return bytes;
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_WINDOWS
+	RingBuffer::RingBuffer(const size_t capacity) noexcept
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		const size_t granularity = info.dwAllocationGranularity;
+		const size_t size = std::max<size_t>((capacity + granularity - 1) / granularity * granularity, granularity);
+
+		const HANDLE section = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+		SOCKLIB_ASSERT(section != nullptr, "Failed to create the RingBuffer section!");
+		if (section == nullptr) return;
+
+		//Find a free range for both views, another thread may grab it in between so retry a few times
+		for (int attempt = 0; attempt < 16 && mData == nullptr; attempt++)
+		{
+			void* range = VirtualAlloc(nullptr, 2 * size, MEM_RESERVE, PAGE_NOACCESS);
+			if (range == nullptr) break;
+			VirtualFree(range, 0, MEM_RELEASE);
+
+			auto* first = static_cast<BYTE*>(MapViewOfFileEx(section, FILE_MAP_ALL_ACCESS, 0, 0, size, range));
+			if (first == nullptr) continue;
+			if (MapViewOfFileEx(section, FILE_MAP_ALL_ACCESS, 0, 0, size, first + size) == nullptr)
+			{
+				UnmapViewOfFile(first);
+				continue;
+			}
+			mData = first;
+			mCapacity = size;
+		}
+		CloseHandle(section);//The views keep the section alive
+		SOCKLIB_ASSERT(mData != nullptr, "Failed to map the RingBuffer!");
+	}
+
+	void RingBuffer::Unmap() noexcept
+	{
+		if (mData == nullptr) return;
+		UnmapViewOfFile(mData + mCapacity);
+		UnmapViewOfFile(mData);
+		mData = nullptr;
+	}
+#else
+	//Anonymous shared memory object of the requested size, -1 on failure
+	static int CreateMemory(const size_t size) noexcept
+	{
+	#ifdef PLATFORM_LINUX
+		const int fd = memfd_create("socklib-ring", MFD_CLOEXEC);
+	#else
+		static std::atomic<uint32_t> counter = 0;
+		const std::string name = "/socklib-ring-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+		const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (fd != -1)
+			shm_unlink(name.c_str());//Only the mappings need it from now on
+	#endif
+		if (fd == -1) return -1;
+		if (ftruncate(fd, static_cast<off_t>(size)) == -1)
+		{
+			close(fd);
+			return -1;
+		}
+		return fd;
+	}
+
+	RingBuffer::RingBuffer(const size_t capacity) noexcept
+	{
+		const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		const size_t size = std::max((capacity + page - 1) / page * page, page);
+
+		const int fd = CreateMemory(size);
+		SOCKLIB_ASSERT(fd != -1, GetError().c_str());
+		if (fd == -1) return;
+
+		//Reserve both halves first so nothing else can end up between the two mappings
+		void* range = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (range != MAP_FAILED)
+		{
+			auto* first = static_cast<BYTE*>(range);
+			const bool mapped = mmap(first, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+				&& mmap(first + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+			if (mapped)
+			{
+				mData = first;
+				mCapacity = size;
+			}
+			else
+				munmap(range, 2 * size);
+		}
+		close(fd);//The mappings keep the memory alive
+		SOCKLIB_ASSERT(mData != nullptr, GetError().c_str());
+	}
+
+	void RingBuffer::Unmap() noexcept
+	{
+		if (mData == nullptr) return;
+		munmap(mData, 2 * mCapacity);
+		mData = nullptr;
+	}
+#endif
+
+}
@@ -0,0 +1,219 @@
+#include <socklib/ShardedServer.h>
+#include <algorithm>
+#ifdef PLATFORM_LINUX
+	#include <linux/filter.h>
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+static void PinThread(std::thread& thread, size_t cpu) noexcept;
+#ifdef PLATFORM_LINUX
+static std::vector<size_t> AllowedCpus() noexcept;
+#endif
+//End Declaration of helper functions
+
+namespace socklib {
+
+	ShardedServer::ShardedServer(const AddressFamily family, const Endpoint& endpoint, Handler handler, const ShardedServerOptions& options) noexcept
+		: mHandler(std::move(handler)), mPinThreads(options.PinThreads)
+	{
+		SOCKLIB_ASSERT(mHandler, "A ShardedServer needs a Handler!");
+		const size_t shards = options.Shards > 0 ? options.Shards : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		mShards.reserve(shards);
+		for (size_t i = 0; i < shards; i++)
+		{
+			auto shard = std::make_unique<Shard>();
+		#ifdef SO_REUSEPORT
+			//The kernel numbers the listeners of a group in the order they start listening,
+			//	so listener i is also the index that the steering program returns for shard i
+			shard->Listener = Socket::CreateServer(family, endpoint, options.Queue, true);
+			shard->Listener.SetBlocking(false);
+		#else
+			if (i == 0)
+			{
+				shard->Listener = Socket::CreateServer(family, endpoint, options.Queue);
+				shard->Listener.SetBlocking(false);
+			}
+			else
+				shard->Listener = mShards.front()->Listener;//No SO_REUSEPORT, every worker accepts from the same queue
+		#endif
+			mShards.push_back(std::move(shard));
+		}
+
+		if (options.SteerByCpu)
+			mSteered = AttachSteering();
+	}
+
+	ShardedServer::~ShardedServer() noexcept { Stop(); }
+
+	void ShardedServer::Start() noexcept
+	{
+		for (size_t i = 0; i < mShards.size(); i++)
+		{
+			Shard& shard = *mShards[i];
+			SOCKLIB_ASSERT(!shard.Worker.joinable(), "The ShardedServer is already started!");
+			shard.Stopping = false;
+			shard.Worker = std::thread([this, &shard]() { Serve(shard); });
+			if (mPinThreads)
+				PinThread(shard.Worker, i);
+		}
+	}
+
+	void ShardedServer::Stop() noexcept
+	{
+		for (const auto& shard : mShards)
+		{
+			shard->Stopping = true;
+			shard->Loop.Wakeup();
+		}
+		for (const auto& shard : mShards)
+		{
+			if (shard->Worker.joinable())
+				shard->Worker.join();
+		}
+	}
+
+	uint64_t ShardedServer::Accepted(const size_t shard) const noexcept
+	{
+		SOCKLIB_ASSERT(shard < mShards.size(), "Shard index out of range!");
+		return mShards[shard]->Accepted.load(std::memory_order_relaxed);
+	}
+
+	uint64_t ShardedServer::AcceptFailures(const size_t shard) const noexcept
+	{
+		SOCKLIB_ASSERT(shard < mShards.size(), "Shard index out of range!");
+		return mShards[shard]->Failures.load(std::memory_order_relaxed);
+	}
+
+	void ShardedServer::Serve(Shard& shard) const noexcept
+	{
+		//Set while the listener is disarmed after a failed accept
+		std::chrono::steady_clock::time_point resume{};
+		bool paused = false;
+
+		shard.Loop.Add(shard.Listener, PollEvent::READABLE, [this, &shard, &resume, &paused](SOCKET, PollEvent)
+		{
+			while (true)
+			{
+				//The new sockets are non-blocking already, and only become Sockets when they are handed over
+				const Result<size_t> count = shard.Listener.AcceptMany(shard.Batch);
+				if (!count)
+				{
+					if (WouldBlock(count.error())) break;//EAGAIN: no more pending connections (or another worker got them first)
+
+					//Out of descriptors or memory: the backlog stays readable, so polling it again right away would spin
+					shard.Failures.fetch_add(1, std::memory_order_relaxed);
+					shard.Loop.Modify(shard.Listener, PollEvent::NONE);
+					resume = std::chrono::steady_clock::now() + ACCEPT_BACKOFF;
+					paused = true;
+					break;
+				}
+				shard.Accepted.fetch_add(*count, std::memory_order_relaxed);
+				for (size_t i = 0; i < *count; i++)
+				{
+					socklib::Accepted& client = shard.Batch[i];
+					mHandler(shard.Loop, Socket(std::move(client.Sock), client.Peer.Family(), false), client.Peer);
+				}
+				if (*count < ACCEPT_BATCH) break;//The backlog is empty
+			}
+		});
+
+		while (!shard.Stopping.load(std::memory_order_acquire))
+		{
+			int32_t millis = -1;
+			if (paused)
+			{
+				const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(resume - std::chrono::steady_clock::now()).count();
+				if (remaining <= 0)
+				{
+					shard.Loop.Modify(shard.Listener, PollEvent::READABLE);
+					paused = false;
+				}
+				else
+					millis = static_cast<int32_t>(remaining);
+			}
+		#ifdef PLATFORM_WINDOWS
+			if (millis < 0 || millis > 50) millis = 50;//WSAPoll() can't be interrupted, so we have to check for Stop() every now and then
+		#endif
+			shard.Loop.Poll(millis);
+		}
+		shard.Loop.Remove(shard.Listener);
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_LINUX
+	bool ShardedServer::AttachSteering() const noexcept
+	{
+		//PinThread puts shard i on the (i % N)-th of the N allowed CPUs, so the k-th allowed CPU
+		//	is steered to shard k % shards. The CPUs aren't always 0..N-1, hence a compare per CPU.
+		const std::vector<size_t> cpus = AllowedCpus();
+		std::vector<sock_filter> code;
+		code.reserve(2 * cpus.size() + 3);
+		code.push_back({ BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) });//A = CPU that is processing the packet
+		for (size_t k = 0; k < cpus.size(); k++)
+		{
+			code.push_back({ BPF_JMP | BPF_JEQ | BPF_K, 0, 1, static_cast<uint32_t>(cpus[k]) });
+			code.push_back({ BPF_RET | BPF_K, 0, 0, static_cast<uint32_t>(k % mShards.size()) });
+		}
+		//A CPU outside the affinity mask has no worker of its own, any listener will do
+		code.push_back({ BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(mShards.size()) });
+		code.push_back({ BPF_RET | BPF_A, 0, 0, 0 });
+		const sock_fprog program = { static_cast<unsigned short>(code.size()), code.data() };
+
+		//The program belongs to the whole group, attaching it to any of the listeners is enough
+		return setsockopt(mShards.front()->Listener.FileNo(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == 0;
+	}
+#else
+	bool ShardedServer::AttachSteering() const noexcept { return false; }
+#endif
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+#if defined(PLATFORM_LINUX)
+static std::vector<size_t> AllowedCpus() noexcept
+{
+	//The CPUs the process is allowed to run on, in ascending order
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	std::vector<size_t> cpus;
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) return cpus;
+	for (size_t i = 0; i < CPU_SETSIZE; i++)
+	{
+		if (CPU_ISSET(i, &allowed))
+			cpus.push_back(i);
+	}
+	return cpus;
+}
+
+static void PinThread(std::thread& thread, const size_t cpu) noexcept
+{
+	//Pick among the CPUs the process is allowed to run on, they are not always 0..N-1
+	const std::vector<size_t> cpus = AllowedCpus();
+	if (cpus.empty()) return;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpus[cpu % cpus.size()], &set);
+	const int result = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+	SOCKLIB_ASSERT(result == 0, "Failed to pin the worker thread!");
+}
+#elif defined(PLATFORM_WINDOWS)
+static void PinThread(std::thread& thread, const size_t cpu) noexcept
+{
+	const size_t cpus = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), 64);
+	const DWORD_PTR result = SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (cpu % cpus));
+	SOCKLIB_ASSERT(result != 0, GetError().c_str());
+}
+#else
+static void PinThread(std::thread&, size_t) noexcept {}//Thread affinity isn't portable on the rest of the Unix-Like systems
+#endif
@@ -1,35 +1,24 @@
 #include <socklib/Socket.h>
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <vector>
 
 //Declaration of helper functions
 void CreateAddress(const char* address, unsigned short port, sockaddr_in& sockAddress) noexcept;
 void CreateAddress(const char* address, unsigned short port, sockaddr_in6& sockAddress) noexcept;
 std::string GetError() noexcept;
-bool HasTimeoutError() noexcept;
 //End Declaration of helper functions
 
 namespace socklib {
 
-	void Socket::Open(const AddressFamily family, const SocketType type, const int proto) noexcept
+	void Socket::Open(const AddressFamily family, const SocketType type, const int proto, const SocketOptions& options) noexcept
 	{
 		if(mSockRef.use_count() == 0)
-			mSockRef = std::make_shared<SOCKET>(INVALID_SOCKET);
-		SOCKET& sock = *mSockRef;
-		SOCKLIB_ASSERT(sock == INVALID_SOCKET, "Socket is already opened!");
-
-		sock = socket(static_cast<int>(family), static_cast<int>(type), proto);
-		SOCKLIB_ASSERT(sock != INVALID_SOCKET, GetError().c_str());
-
-#ifdef PLATFORM_WINDOWS
-		constexpr BOOL val = TRUE;
-		const int result = setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&val, sizeof(BOOL));
-#else
-		constexpr int val = 1;
-		const int result = setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(int));
-#endif
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, "Failed to set SO_REUSEADDR!");
-
+			mSockRef = std::make_shared<UniqueSocket>();
+		mSockRef->Open(family, type, proto, options);
 		mAF = family;
+		mBlockMode = !options.NonBlocking;
 	}
 
 	void Socket::Bind(const char* address, const unsigned short port) const noexcept
@@ -60,27 +49,23 @@ namespace socklib {
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
 		SOCKLIB_ASSERT(mAF == static_cast<AddressFamily>(address->sa_family), "Socket hasn't opened with same address Family!");
-		const int result = bind(*mSockRef, address, size);
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		mSockRef->Bind(address, size);
 	}
 
+	void Socket::Bind(const SocketAddress& address) const noexcept { Bind(address.Data(), address.Size()); }
+
 	void Socket::Bind(const std::string& address, const unsigned short port) const noexcept { Bind(address.c_str(), port);  }
 
 	void Socket::Shutdown(const int how) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed!");
-		const int result = shutdown(*mSockRef, how);
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		mSockRef->Shutdown(how);
 	}
 
 	void Socket::Close() noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed!");
-		const int result = closesocket(*mSockRef);
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
-		*mSockRef = INVALID_SOCKET;
+		mSockRef->Close();
 		mAF = AddressFamily::UNSPECIFIED;
 	}
 
@@ -116,104 +101,59 @@ namespace socklib {
 	void Socket::Connect(const sockaddr* address, const socklen_t size) const noexcept
 	{
 		SOCKLIB_ASSERT(mAF == static_cast<AddressFamily>(address->sa_family), "Socket hasn't opened with same address Family!");
-		const int result = connect(*mSockRef, address, size);
-		if (HasTimeoutError()) return;
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		const Result<void> result = mSockRef->TryConnect(SocketAddress(address, size));
+		//Only a non-blocking connect may still be in progress, on a blocking socket that means SO_SNDTIMEO expired
+		SOCKLIB_ASSERT(result || (!mBlockMode && WouldBlock(result.error())), result.error().message().c_str());
 	}
 
+	void Socket::Connect(const SocketAddress& address) const noexcept { Connect(address.Data(), address.Size()); }
+
 	void Socket::Connect(const std::string& address, const unsigned short port) const noexcept { Connect(address.c_str(), port); }
 
 	void Socket::Listen(const int length) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-		const int result = listen(*mSockRef, length);
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		mSockRef->Listen(length);
 	}
 
 	std::pair<Socket, Endpoint> Socket::Accept() const noexcept
 	{
-		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-		Socket clientSock{};
-		
-		std::string ip;
-		unsigned short port = 0;
-		switch (mAF)
-		{
-		case AddressFamily::IPv4:
-		{
-			char buffer[16] = { 0 };
-			sockaddr_in address = { 0 };
-			socklen_t size = sizeof(sockaddr_in);
-			clientSock = Accept(reinterpret_cast<sockaddr*>(&address), &size);
-			if (HasTimeoutError()) return std::make_pair<Socket, Endpoint>({}, {});
-			inet_ntop(AF_INET, &address.sin_addr, buffer, 16);
-			ip = std::string(buffer);
-			port = ntohs(address.sin_port);
-			break;
-		}
-		case AddressFamily::IPv6:
-		{
-			char buffer[46] = { 0 };
-			sockaddr_in6 address = { 0 };
-			socklen_t size = sizeof(sockaddr_in6);
-			clientSock = Accept(reinterpret_cast<sockaddr*>(&address), &size);
-
-			if (HasTimeoutError()) return std::make_pair<Socket, Endpoint>({}, {});
-			inet_ntop(AF_INET6, &address.sin6_addr, buffer, 46);
-			ip = std::string(buffer);
-			port = ntohs(address.sin6_port);
-			break;
-		}
-		default:
-			break;
-		}
-
-		clientSock.mAF = mAF;
-		return std::make_pair(clientSock, Endpoint{ ip, port });
+		SOCKLIB_ASSERT(mAF == AddressFamily::IPv4 || mAF == AddressFamily::IPv6, "Currently only IPv4 and IPv6 is supported!");
+		SocketAddress address;
+		Socket clientSock = Accept(address);
+		if (clientSock.FileNo() == INVALID_SOCKET) return std::make_pair<Socket, Endpoint>({}, {});
+		return std::make_pair(std::move(clientSock), address.ToEndpoint());
 	}
 
 	Socket Socket::Accept(sockaddr* address, socklen_t* size) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-
-		Socket client{};
-		client.mSockRef = std::make_shared<SOCKET>(accept(*mSockRef, address, size));
+		UniqueSocket client = mSockRef->Accept(address, size);
+		if (client.FileNo() == INVALID_SOCKET) return {};
+		return { std::move(client), mAF };
+	}
 
-		if (HasTimeoutError()) return{};
-		SOCKLIB_ASSERT(*client.mSockRef != INVALID_SOCKET, GetError().c_str());
-		client.mAF = mAF;
 
-		return client;
+	Socket Socket::Accept(SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		UniqueSocket client = mSockRef->Accept(address);
+		if (client.FileNo() == INVALID_SOCKET) return {};
+		return { std::move(client), mAF };
 	}
 
-
 	IOSize Socket::Send(const void* data, const size_t length, const size_t offset) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-		const char* buffer = static_cast<const char*>(data) + offset;
-
-		const IOSize bytes = send(*mSockRef, buffer, length, 0);
-
-		if (HasTimeoutError()) return -1;
-		SOCKLIB_ASSERT(bytes != -1, GetError().c_str());
-		return bytes;
+		return mSockRef->Send(data, length, offset);
 	}
 
 	IOSize Socket::SendTo(const void* data, const sockaddr* address, const socklen_t addressSize, const size_t length, const size_t offset) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
 		SOCKLIB_ASSERT(mAF == static_cast<AddressFamily>(address->sa_family), "Socket hasn't opened with same address Family!");
-		const char* buffer = static_cast<const char *>(data) + offset;
-
-		const IOSize bytes = sendto(*mSockRef, buffer, length, 0, address, addressSize);
-
-		SOCKLIB_ASSERT(bytes != -1, GetError().c_str());
-		return bytes;
+		return mSockRef->SendTo(data, address, addressSize, length, offset);
 	}
 
 	IOSize Socket::SendTo(const void* data, const Endpoint& endpoint, const size_t length, const size_t offset) const noexcept
@@ -238,72 +178,36 @@ namespace socklib {
 		}
 	}
 
+	IOSize Socket::SendTo(const void* data, const SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		return SendTo(data, address.Data(), address.Size(), length, offset);
+	}
+
 	IOSize Socket::Receive(void* data, const size_t length, const size_t offset) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-		char* buffer = static_cast<char*>(data) + offset;
-
-		const IOSize bytes = recv(*mSockRef, buffer, length, 0);
-
-		if (HasTimeoutError()) return -1;
-		SOCKLIB_ASSERT(bytes != -1, GetError().c_str());
-		return bytes;
+		return mSockRef->Receive(data, length, offset);
 	}
 
 	IOSize Socket::ReceiveFrom(void* data, sockaddr* address, socklen_t* addressSize, const size_t length, const size_t offset) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-
-		char* buffer = static_cast<char *>(data) + offset;
-
-		const IOSize bytes = recvfrom(*mSockRef, buffer, length, 0, address, addressSize);
-
-		if (bytes == -1 && HasTimeoutError()) return -1;
-		SOCKLIB_ASSERT(bytes != -1, GetError().c_str());
-		return bytes;
+		return mSockRef->ReceiveFrom(data, address, addressSize, length, offset);
 	}
 
 	std::pair<IOSize, Endpoint> Socket::ReceiveFrom(void* data, const size_t length, const size_t offset) const noexcept
 	{
-		std::string ip;
-		unsigned short port = 0;
-		IOSize bytes = SOCKET_ERROR;
-		switch (mAF)
-		{
-			case AddressFamily::IPv4:
-			{
-				char buffer[16] = { 0 };
-				sockaddr_in address = { 0 };
-				socklen_t addressSize = sizeof(sockaddr_in);
-				bytes = ReceiveFrom(data, reinterpret_cast<sockaddr*>(&address), &addressSize, length, offset);
-
-				if (bytes == -1 && HasTimeoutError()) return std::make_pair(-1, Endpoint{});
-				inet_ntop(AF_INET, &address.sin_addr, buffer, 16);
-				ip = std::string(buffer);
-				port = ntohs(address.sin_port);
-				break;
-			}
-			case AddressFamily::IPv6:
-			{
-				char buffer[46] = { 0 };
-				sockaddr_in6 address = { 0 };
-				socklen_t addressSize = sizeof(sockaddr_in6);
-				bytes = ReceiveFrom(data, reinterpret_cast<sockaddr*>(&address), &addressSize, length, offset);
-
-				if (bytes == -1 && HasTimeoutError()) return std::make_pair(-1, Endpoint{});
-				SOCKLIB_ASSERT(bytes != -1, GetError().c_str());
-				inet_ntop(AF_INET6, &address.sin6_addr, buffer, 46);
-				ip = std::string(buffer);
-				port = ntohs(address.sin6_port);
-				break;
-			}
-			default:
-				SOCKLIB_ASSERT(false, "Not supported address family!");
-			return std::make_pair(SOCKET_ERROR, Endpoint {"", 0 });//Not suppose to be reached
-		}
-		return std::make_pair(bytes, Endpoint{ ip, port });
+		SOCKLIB_ASSERT(mAF == AddressFamily::IPv4 || mAF == AddressFamily::IPv6, "Not supported address family!");
+		SocketAddress address;
+		const IOSize bytes = ReceiveFrom(data, address, length, offset);
+		if (bytes == -1) return std::make_pair(-1, Endpoint{});
+		return std::make_pair(bytes, address.ToEndpoint());
+	}
+
+	IOSize Socket::ReceiveFrom(void* data, SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveFrom(data, address, length, offset);
 	}
 
 	Socket::Socket(Socket&& other) noexcept
@@ -320,9 +224,6 @@ namespace socklib {
 	{
 		if (this == &rhs) return *this;
 
-		if ((mSockRef.use_count() == 1) && (*mSockRef != INVALID_SOCKET))
-			Close();
-
 		mAF = rhs.mAF;
 		mBlockMode = rhs.mBlockMode;
 
@@ -332,74 +233,301 @@ namespace socklib {
 		return *this;
 	}
 
-	Socket::~Socket() noexcept
+	Socket::Socket(UniqueSocket&& sock, const AddressFamily family, const bool blocking) noexcept
+		: mSockRef(std::make_shared<UniqueSocket>(std::move(sock))), mBlockMode(blocking), mAF(family) {}
+
+	Socket::~Socket() noexcept = default;//The last reference closes the UniqueSocket
+
+	Socket Socket::CreateConnection(const AddressFamily family, const Endpoint& endpoint, const uint32_t timeout, const Endpoint& local) noexcept
 	{
-		if ((mSockRef.use_count() == 1) && (*mSockRef != INVALID_SOCKET))
-			Close();
+		return CreateConnection(family, endpoint, SocketOptions(), timeout, local);
 	}
 
-	Socket Socket::CreateConnection(const AddressFamily family, const Endpoint& endpoint, const uint32_t timeout, const Endpoint& local) noexcept
+	Socket Socket::CreateConnection(const AddressFamily family, const Endpoint& endpoint, const SocketOptions& options, const uint32_t timeout, const Endpoint& local) noexcept
 	{
-		Socket client(family, SocketType::STREAM, IPPROTO_TCP);
+		Socket client(family, SocketType::STREAM, IPPROTO_TCP, options);
 		client.Bind(local.Host, local.Port);
-		if(timeout > 0)
-			client.SetTimeout(timeout);
-		client.Connect(endpoint.Host, endpoint.Port);
-		return client;
+		if (timeout == 0)
+		{
+			client.Connect(endpoint.Host, endpoint.Port);
+			return client;
+		}
+
+		const Result<void> connected = client.TryConnect(SocketAddress::Parse(endpoint), timeout);
+		if (connected) return client;
+		SOCKLIB_ASSERT(connected.error() == std::errc::timed_out, connected.error().message().c_str());
+		return {};
 	}
 
-	// ************************************************************************
-	// | Bellow from here the implementation differ depending on the Platform |
-	// ************************************************************************
+	Socket Socket::CreateServer(const AddressFamily family, const Endpoint& endpoint, const int queue, const bool reusePort) noexcept
+	{
+		SocketOptions options;
+		options.ReusePort = reusePort;
+		return CreateServer(family, endpoint, options, queue);
+	}
 
-	Socket Socket::CreateServer(const AddressFamily family, const Endpoint& endpoint, const int queue) noexcept
+	Socket Socket::CreateServer(const AddressFamily family, const Endpoint& endpoint, const SocketOptions& options, const int queue) noexcept
 	{
-		Socket server(family, SocketType::STREAM, IPPROTO_TCP);
+		Socket server(family, SocketType::STREAM, IPPROTO_TCP, options);
 		server.Bind(endpoint.Host, endpoint.Port);
 		server.Listen(queue);
 		return server;
 	}
 
-	void Socket::SetBlocking(bool flag) noexcept
+	IOSize Socket::SendV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendV(buffers);
+	}
+
+	IOSize Socket::SendToV(const std::span<const IOBuffer> buffers, const sockaddr* address, const socklen_t addressSize) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendToV(buffers, address, addressSize);
+	}
+
+	IOSize Socket::ReceiveV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveV(buffers);
+	}
+
+	IOSize Socket::ReceiveFromV(const std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveFromV(buffers, address, addressSize);
+	}
+
+	IOSize Socket::ReceiveBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveBatch(datagrams);
+	}
+
+	IOSize Socket::SendBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendBatch(datagrams);
+	}
+
+	IOSize Socket::SendFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendFile(fd, offset, count);
+	}
+
+	IOSize Socket::ReceiveToFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveToFile(fd, offset, count);
+	}
+
+	Result<void> Socket::TryBind(const SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryBind(address);
+	}
+
+	Result<void> Socket::TryShutdown(const int how) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryShutdown(how);
+	}
+
+	Result<void> Socket::TryConnect(const SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryConnect(address);
+	}
+
+	Result<void> Socket::TryConnect(const SocketAddress& address, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryConnect(address, timeout, mBlockMode);
+	}
+
+	Result<Socket> Socket::TryConnectFirst(const std::span<const SocketAddress> candidates, const uint32_t timeout, size_t* winner) noexcept
+	{
+		Result<std::pair<UniqueSocket, size_t>> connected = UniqueSocket::TryConnectFirst(candidates, timeout);
+		if (!connected)
+			return Unexpected(connected.error());
+		if (winner != nullptr)
+			*winner = connected->second;
+		return Socket(std::move(connected->first), candidates[connected->second].Family());
+	}
+
+	Result<Socket> Socket::TryConnectDualStack(const std::span<const SocketAddress> addresses, const uint32_t timeout, const uint32_t stagger, size_t* winner) noexcept
+	{
+		//Alternate the families starting with IPv6, keeping the order within each family
+		std::vector<size_t> order;
+		order.reserve(addresses.size());
+		size_t v6 = 0, v4 = 0;
+		auto nextOf = [&addresses](size_t& index, const AddressFamily family)
+		{
+			while (index < addresses.size() && addresses[index].Family() != family)
+				index++;
+			return index < addresses.size() ? index++ : addresses.size();
+		};
+		for (bool ipv6 = true; order.size() < addresses.size(); ipv6 = !ipv6)
+		{
+			size_t index = ipv6 ? nextOf(v6, AddressFamily::IPv6) : nextOf(v4, AddressFamily::IPv4);
+			if (index == addresses.size())
+			{
+				//One family ran out, the rest of the other goes in order (as do addresses of neither)
+				for (size_t i = 0; i < addresses.size(); i++)
+					if (std::find(order.begin(), order.end(), i) == order.end())
+						order.push_back(i);
+				break;
+			}
+			order.push_back(index);
+		}
+
+		std::vector<SocketAddress> candidates;
+		candidates.reserve(order.size());
+		for (const size_t index : order)
+			candidates.push_back(addresses[index]);
+
+		Result<std::pair<UniqueSocket, size_t>> connected = UniqueSocket::TryConnectFirst(candidates, timeout, stagger);
+		if (!connected)
+			return Unexpected(connected.error());
+		if (winner != nullptr)
+			*winner = order[connected->second];
+		return Socket(std::move(connected->first), candidates[connected->second].Family());
+	}
+
+	Result<void> Socket::TryListen(const int length) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryListen(length);
+	}
+
+	Result<Socket> Socket::TryAccept() const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		Result<UniqueSocket> client = mSockRef->TryAccept();
+		if (!client) return Unexpected(client.error());
+		return Socket(std::move(*client), mAF);
+	}
+
+	Result<Socket> Socket::TryAccept(SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		Result<UniqueSocket> client = mSockRef->TryAccept(address);
+		if (!client) return Unexpected(client.error());
+		return Socket(std::move(*client), mAF);
+	}
+
+	Result<size_t> Socket::AcceptMany(const std::span<Accepted> connections) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->AcceptMany(connections);
+	}
+
+	Result<size_t> Socket::TrySend(const void* data, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TrySend(data, length, offset);
+	}
+
+	Result<size_t> Socket::TrySendTo(const void* data, const SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TrySendTo(data, address, length, offset);
+	}
+
+	Result<size_t> Socket::TryReceive(void* data, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryReceive(data, length, offset);
+	}
+
+	Result<size_t> Socket::TryReceiveFrom(void* data, SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryReceiveFrom(data, address, length, offset);
+	}
+
+	Result<size_t> Socket::TrySendV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TrySendV(buffers);
+	}
+
+	Result<size_t> Socket::TryReceiveV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryReceiveV(buffers);
+	}
+
+	Result<void> Socket::SendAll(const void* data, const size_t length, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendAll(data, length, timeout);
+	}
+
+	Result<void> Socket::SendAllV(const std::span<IOBuffer> buffers, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->SendAllV(buffers, timeout);
+	}
+
+	Result<void> Socket::ReceiveExact(void* data, const size_t length, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveExact(data, length, timeout);
+	}
+
+	Result<void> Socket::ReceiveExactV(const std::span<IOBuffer> buffers, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->ReceiveExactV(buffers, timeout);
+	}
+
+	Result<size_t> Socket::TryReceiveBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryReceiveBatch(datagrams);
+	}
+
+	Result<size_t> Socket::TrySendBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TrySendBatch(datagrams);
+	}
+
+	Result<size_t> Socket::TrySendFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TrySendFile(fd, offset, count);
+	}
+
+	Result<size_t> Socket::TryReceiveToFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		return mSockRef->TryReceiveToFile(fd, offset, count);
+	}
+
+	void Socket::SetBlocking(const bool flag) noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
 		if (flag == mBlockMode) return;
-		int result = SOCKET_ERROR;
-	#ifdef PLATFORM_WINDOWS
-		unsigned long iMode = (unsigned long)!flag;
-		result = ioctlsocket(*mSockRef, FIONBIO, &iMode);
-	#else
-		int flags = fcntl(*mSockRef, F_GETFL);
-		flags = !flag ? (flags | O_NONBLOCK) : (flags & (~O_NONBLOCK));
-		result = ioctl(*mSockRef, F_SETFL, flags);
-	#endif
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		mSockRef->SetBlocking(flag);
 		mBlockMode = flag;
 	}
 
 	void Socket::SetTimeout(const uint32_t millis) const noexcept
 	{
 		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
-		SOCKLIB_ASSERT(*mSockRef != INVALID_SOCKET, "The Socket is already closed");
-		int result;
-	#ifdef PLATFORM_WINDOWS
-		result = setsockopt(*mSockRef, SOL_SOCKET, SO_SNDTIMEO, (char*)&millis, sizeof(uint32_t));
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
-		result = setsockopt(*mSockRef, SOL_SOCKET, SO_RCVTIMEO, (char*)&millis, sizeof(uint32_t));
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
-	#else
-		timeval timeout{};
-		timeout.tv_sec = static_cast<long>(millis) / 1000;
-		timeout.tv_usec = (static_cast<long>(millis) % 1000)* 1000;
-		result = setsockopt(*mSockRef, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeval));
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
-		result = setsockopt(*mSockRef, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeval));
-		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
-	#endif
+		mSockRef->SetTimeout(millis);
 	}
 
-	SOCKET Socket::FileNo() const noexcept { return mSockRef.use_count() == 0 ? INVALID_SOCKET : *mSockRef; }
+	void Socket::SetReusePort(const bool flag) const noexcept
+	{
+		SOCKLIB_ASSERT(mSockRef.use_count() >= 1, "Socket is not opened!");
+		mSockRef->SetReusePort(flag);
+	}
+
+	SOCKET Socket::FileNo() const noexcept { return mSockRef.use_count() == 0 ? INVALID_SOCKET : mSockRef->FileNo(); }
 
 }
 
@@ -447,28 +575,10 @@ void CreateAddress(const char* address, const unsigned short port, sockaddr_in6&
 			rdata = std::string("Unknown error!");
 		return rdata;
 	}
-
-	bool HasTimeoutError() noexcept
-	{
-		const int err = WSAGetLastError();
-		if (err == WSAEWOULDBLOCK || err == WSAETIMEDOUT)
-			return true;
-		WSASetLastError(err);
-		return false;
-	}
 #else//Unix like platforms
 	std::string GetError() noexcept
 	{
 		const int err = errno;
 		return { strerror(err) };
 	}
-
-	bool HasTimeoutError() noexcept
-	{
-		const int err = errno;
-		if (err == EAGAIN || err == ETIMEDOUT)
-			return true;
-		errno = err;
-		return false;
-	}
 #endif
\ No newline at end of file
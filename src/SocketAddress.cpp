@@ -0,0 +1,156 @@
+#include <socklib/Socket.h>
+#include <algorithm>
+#include <cstring>
+
+namespace socklib {
+
+	SocketAddress::SocketAddress(const sockaddr* address, const socklen_t size) noexcept
+		: mSize(std::min<socklen_t>(size, Capacity()))
+	{
+		memcpy(&mStorage, address, mSize);
+	}
+
+	SocketAddress SocketAddress::Parse(const char* host, const unsigned short port) noexcept
+	{
+		SocketAddress address;
+		if (host == nullptr) return address;
+
+		auto& v4 = reinterpret_cast<sockaddr_in&>(address.mStorage);
+		if (inet_pton(AF_INET, host, &v4.sin_addr) == 1)
+		{
+			v4.sin_family = AF_INET;
+			v4.sin_port = htons(port);
+			address.mSize = sizeof(sockaddr_in);
+			return address;
+		}
+
+		auto& v6 = reinterpret_cast<sockaddr_in6&>(address.mStorage);
+		if (inet_pton(AF_INET6, host, &v6.sin6_addr) == 1)
+		{
+			v6.sin6_family = AF_INET6;
+			v6.sin6_port = htons(port);
+			address.mSize = sizeof(sockaddr_in6);
+			return address;
+		}
+
+		return {};
+	}
+
+	SocketAddress SocketAddress::Any(const AddressFamily family, const unsigned short port) noexcept
+	{
+		SocketAddress address;
+		switch (family)
+		{
+		case AddressFamily::IPv4:
+		{
+			auto& v4 = reinterpret_cast<sockaddr_in&>(address.mStorage);
+			v4.sin_family = AF_INET;
+			v4.sin_port = htons(port);
+			v4.sin_addr.s_addr = INADDR_ANY;
+			address.mSize = sizeof(sockaddr_in);
+			break;
+		}
+		case AddressFamily::IPv6:
+		{
+			auto& v6 = reinterpret_cast<sockaddr_in6&>(address.mStorage);
+			v6.sin6_family = AF_INET6;
+			v6.sin6_port = htons(port);
+			v6.sin6_addr = in6addr_any;
+			address.mSize = sizeof(sockaddr_in6);
+			break;
+		}
+		default:
+			SOCKLIB_ASSERT(false, "Currently only IPv4 and IPv6 is supported!");
+			break;
+		}
+		return address;
+	}
+
+	unsigned short SocketAddress::Port() const noexcept
+	{
+		switch (Family())
+		{
+		case AddressFamily::IPv4: return ntohs(reinterpret_cast<const sockaddr_in&>(mStorage).sin_port);
+		case AddressFamily::IPv6: return ntohs(reinterpret_cast<const sockaddr_in6&>(mStorage).sin6_port);
+		default: return 0;
+		}
+	}
+
+	std::string SocketAddress::Host() const
+	{
+		char buffer[INET6_ADDRSTRLEN] = { 0 };
+		switch (Family())
+		{
+		case AddressFamily::IPv4:
+			inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in&>(mStorage).sin_addr, buffer, INET6_ADDRSTRLEN);
+			break;
+		case AddressFamily::IPv6:
+			inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6&>(mStorage).sin6_addr, buffer, INET6_ADDRSTRLEN);
+			break;
+		default:
+			break;
+		}
+		return { buffer };
+	}
+
+	std::string SocketAddress::ToString() const
+	{
+		if (Family() == AddressFamily::IPv6)
+			return "[" + Host() + "]:" + std::to_string(Port());
+		return Host() + ":" + std::to_string(Port());
+	}
+
+	size_t SocketAddress::Hash() const noexcept
+	{
+		//FNV-1a over the family, port and IP address bytes
+		auto mix = [](size_t hash, const void* data, const size_t size)
+		{
+			const auto* bytes = static_cast<const BYTE*>(data);
+			for (size_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ULL;
+			return hash;
+		};
+
+		size_t hash = mix(14695981039346656037ULL, &mStorage.ss_family, sizeof(mStorage.ss_family));
+		switch (Family())
+		{
+		case AddressFamily::IPv4:
+		{
+			const auto& v4 = reinterpret_cast<const sockaddr_in&>(mStorage);
+			hash = mix(hash, &v4.sin_port, sizeof(v4.sin_port));
+			return mix(hash, &v4.sin_addr, sizeof(v4.sin_addr));
+		}
+		case AddressFamily::IPv6:
+		{
+			const auto& v6 = reinterpret_cast<const sockaddr_in6&>(mStorage);
+			hash = mix(hash, &v6.sin6_port, sizeof(v6.sin6_port));
+			return mix(hash, &v6.sin6_addr, sizeof(v6.sin6_addr));
+		}
+		default:
+			return hash;
+		}
+	}
+
+	bool SocketAddress::operator==(const SocketAddress& rhs) const noexcept
+	{
+		if (mStorage.ss_family != rhs.mStorage.ss_family) return false;
+		switch (Family())
+		{
+		case AddressFamily::IPv4:
+		{
+			const auto& a = reinterpret_cast<const sockaddr_in&>(mStorage);
+			const auto& b = reinterpret_cast<const sockaddr_in&>(rhs.mStorage);
+			return a.sin_port == b.sin_port && a.sin_addr.s_addr == b.sin_addr.s_addr;
+		}
+		case AddressFamily::IPv6:
+		{
+			const auto& a = reinterpret_cast<const sockaddr_in6&>(mStorage);
+			const auto& b = reinterpret_cast<const sockaddr_in6&>(rhs.mStorage);
+			return a.sin6_port == b.sin6_port && a.sin6_scope_id == b.sin6_scope_id && memcmp(&a.sin6_addr, &b.sin6_addr, sizeof(in6_addr)) == 0;
+		}
+		default:
+			return mSize == rhs.mSize && memcmp(&mStorage, &rhs.mStorage, mSize) == 0;
+		}
+	}
+
+}
@@ -0,0 +1,102 @@
+#include <socklib/Task.h>
+
+namespace socklib {
+
+	AcceptAwaitable Socket::AsyncAccept(Poller& poller) const noexcept { return { poller, *this, nullptr }; }
+
+	AcceptAwaitable Socket::AsyncAccept(Poller& poller, SocketAddress& address) const noexcept { return { poller, *this, &address }; }
+
+	ConnectAwaitable Socket::AsyncConnect(Poller& poller, const SocketAddress& address) const noexcept { return { poller, *this, address }; }
+
+	ReceiveAwaitable Socket::AsyncReceive(Poller& poller, void* data, const size_t length) const noexcept { return { poller, *this, data, length }; }
+
+	SendAwaitable Socket::AsyncSend(Poller& poller, const void* data, const size_t length) const noexcept { return { poller, *this, data, length }; }
+
+	IOAwaitable::IOAwaitable(Poller& poller, const Socket& sock, const PollEvent interest) noexcept
+		: mPoller(poller), mSock(sock), mInterest(interest)
+	{
+		SOCKLIB_ASSERT(sock.FileNo() != INVALID_SOCKET, "The Socket is not opened!");
+		SOCKLIB_ASSERT(!sock.IsBlocking(), "Async operations require a non-blocking Socket!");
+	}
+
+	IOAwaitable::~IOAwaitable() noexcept
+	{
+		//The coroutine was destroyed while suspended, the Poller must not call back into its frame
+		if (mRegistered != INVALID_SOCKET)
+			mPoller.Remove(mRegistered);
+	}
+
+	void IOAwaitable::await_suspend(const std::coroutine_handle<> handle) noexcept
+	{
+		mHandle = handle;
+		mRegistered = mSock.FileNo();
+		mPoller.Add(mRegistered, mInterest, [this](SOCKET, PollEvent) { OnReady(); });
+	}
+
+	void IOAwaitable::OnReady() noexcept
+	{
+		if (!Attempt()) return;//Spurious wake up, keep waiting
+		mPoller.Remove(mRegistered);
+		mRegistered = INVALID_SOCKET;
+		mHandle.resume();//Might destroy this awaitable, so it must be the last thing we do
+	}
+
+	bool AcceptAwaitable::Attempt() noexcept
+	{
+		Result<Socket> client = mAddress != nullptr ? mSock.TryAccept(*mAddress) : mSock.TryAccept();
+		if (!client && WouldBlock(client.error())) return false;
+		if (client) client->SetBlocking(false);
+		mResult = std::move(client);
+		return true;
+	}
+
+	bool ConnectAwaitable::Attempt() noexcept
+	{
+		if (!mStarted)
+		{
+			mStarted = true;
+			mResult = mSock.TryConnect(mAddress);
+			return mResult || !WouldBlock(mResult.error());
+		}
+
+		//Writable means the connection attempt is over, SO_ERROR tells how it went
+		int error = 0;
+		socklen_t size = sizeof(int);
+		if (getsockopt(mSock.FileNo(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == SOCKET_ERROR)
+		{
+		#ifdef PLATFORM_WINDOWS
+			error = WSAGetLastError();
+		#else
+			error = errno;
+		#endif
+		}
+		const std::error_code code(error, std::system_category());
+		if (error != 0 && WouldBlock(code)) return false;
+		mResult = error == 0 ? Result<void>() : Result<void>(Unexpected(code));
+		return true;
+	}
+
+	bool ReceiveAwaitable::Attempt() noexcept
+	{
+		mResult = mSock.TryReceive(mData, mLength);
+		return mResult || !WouldBlock(mResult.error());
+	}
+
+	bool SendAwaitable::Attempt() noexcept
+	{
+		while (mSent < mLength)
+		{
+			const Result<size_t> bytes = mSock.TrySend(mData, mLength - mSent, mSent);
+			if (!bytes)
+			{
+				if (WouldBlock(bytes.error())) return false;
+				mResult = bytes;
+				return true;
+			}
+			mSent += *bytes;
+		}
+		mResult = mSent;
+		return true;
+	}
+
+}
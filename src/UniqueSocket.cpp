@@ -0,0 +1,1083 @@
+#include <socklib/Socket.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <vector>
+#ifdef PLATFORM_LINUX
+	#include <sys/sendfile.h>
+#elif defined(PLATFORM_WINDOWS)
+	#include <io.h>
+#endif
+#ifndef PLATFORM_WINDOWS
+	#include <netinet/tcp.h>
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+static std::error_code LastError() noexcept;
+static bool IsInterrupted(const std::error_code& error) noexcept;
+static bool IsAborted(const std::error_code& error) noexcept;
+static std::error_code TimedOut() noexcept;
+static socklib::Result<void> WaitFor(socklib::SOCKET sock, short events, std::chrono::steady_clock::time_point deadline) noexcept;
+static socklib::Result<void> WaitForAny(std::span<pollfd> fds, std::chrono::steady_clock::time_point deadline) noexcept;
+static socklib::Result<void> ConnectError(socklib::SOCKET sock) noexcept;
+static socklib::SOCKET CreateSocket(int family, int type, int proto, const socklib::SocketOptions& options) noexcept;
+static bool SetOption(socklib::SOCKET sock, int level, int name, int value) noexcept;
+static socklib::SOCKET AcceptNonBlocking(socklib::SOCKET listener, sockaddr* address, socklen_t* size) noexcept;
+#ifndef PLATFORM_LINUX
+static socklib::IOSize ReadFileAt(int fd, void* data, size_t length, uint64_t offset) noexcept;
+static bool WriteFileAt(int fd, const void* data, size_t length, uint64_t offset) noexcept;
+#endif
+//End Declaration of helper functions
+
+namespace socklib {
+
+#ifdef PLATFORM_WINDOWS
+	static constexpr int DONT_WAIT = 0;//Windows has no per call flag, WaitFor makes sure the socket is ready instead
+#else
+	static constexpr int DONT_WAIT = MSG_DONTWAIT;
+#endif
+
+	//Invokes a send/receive like call, restarting it if it is interrupted by a signal
+	template<typename Call>
+	static Result<size_t> Retry(Call&& call) noexcept
+	{
+		while (true)
+		{
+			const auto bytes = call();
+			if (bytes != -1) return static_cast<size_t>(bytes);
+			const std::error_code error = LastError();
+			if (!IsInterrupted(error)) return Unexpected(error);
+		}
+	}
+
+	static Result<void> Check(const int result) noexcept
+	{
+		if (result == SOCKET_ERROR) return Unexpected(LastError());
+		return {};
+	}
+
+	//Accepts a connection, restarting the call if it is interrupted by a signal
+	static Result<UniqueSocket> AcceptSocket(const SOCKET listener, sockaddr* address, socklen_t* size) noexcept
+	{
+		while (true)
+		{
+			const SOCKET client = accept(listener, address, size);
+			if (client != INVALID_SOCKET) return UniqueSocket(client);
+			const std::error_code error = LastError();
+			if (!IsInterrupted(error)) return Unexpected(error);
+		}
+	}
+
+	static Result<void> ConnectSocket(const SOCKET sock, const sockaddr* address, const socklen_t size) noexcept
+	{
+		if (connect(sock, address, size) != SOCKET_ERROR) return {};
+		const std::error_code error = LastError();
+	#ifndef PLATFORM_WINDOWS
+		//An interrupted connect keeps going asynchronously, just like a non-blocking one
+		if (IsInterrupted(error)) return Unexpected(std::error_code(EINPROGRESS, std::system_category()));
+	#endif
+		return Unexpected(error);
+	}
+
+	//The classic convention of the methods that don't return a Result: -1 (or a closed socket)
+	//	when the call would block or timed out (ETIMEDOUT included, as it always was), any other failure is asserted
+	[[maybe_unused]] static bool IsTimeout(const std::error_code& error) noexcept { return WouldBlock(error) || error == TimedOut(); }
+
+	static IOSize Unwrap(const Result<size_t>& result) noexcept
+	{
+		if (result) return static_cast<IOSize>(*result);
+		SOCKLIB_ASSERT(IsTimeout(result.error()), result.error().message().c_str());
+		return -1;
+	}
+
+	static UniqueSocket Unwrap(Result<UniqueSocket>&& result) noexcept
+	{
+		if (result) return std::move(*result);
+		SOCKLIB_ASSERT(IsTimeout(result.error()), result.error().message().c_str());
+		return {};
+	}
+
+	static void Unwrap(const Result<void>& result) noexcept
+	{
+		SOCKLIB_ASSERT(result || IsTimeout(result.error()), result.error().message().c_str());
+	}
+
+	UniqueSocket::~UniqueSocket() noexcept
+	{
+		if (mSock != INVALID_SOCKET)
+			Close();
+	}
+
+	UniqueSocket& UniqueSocket::operator=(UniqueSocket&& rhs) noexcept
+	{
+		if (this == &rhs) return *this;
+
+		if (mSock != INVALID_SOCKET)
+			Close();
+
+		mSock = rhs.mSock;
+		rhs.mSock = INVALID_SOCKET;
+		return *this;
+	}
+
+	void UniqueSocket::Open(const AddressFamily family, const SocketType type, const int proto, const SocketOptions& options) noexcept
+	{
+		SOCKLIB_ASSERT(mSock == INVALID_SOCKET, "Socket is already opened!");
+
+		mSock = CreateSocket(static_cast<int>(family), static_cast<int>(type), proto, options);
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, GetError().c_str());
+		if (mSock == INVALID_SOCKET) return;
+
+		//Only what differs from the system defaults, every option is a system call
+		bool result = true;
+		if (options.ReuseAddress)
+			result &= SetOption(mSock, SOL_SOCKET, SO_REUSEADDR, 1);
+		if (options.ReusePort)
+			SetReusePort(true);
+		if (options.NoDelay && type == SocketType::STREAM)
+			result &= SetOption(mSock, IPPROTO_TCP, TCP_NODELAY, 1);
+		if (options.KeepAlive)
+			result &= SetOption(mSock, SOL_SOCKET, SO_KEEPALIVE, 1);
+		if (options.SendBuffer > 0)
+			result &= SetOption(mSock, SOL_SOCKET, SO_SNDBUF, options.SendBuffer);
+		if (options.ReceiveBuffer > 0)
+			result &= SetOption(mSock, SOL_SOCKET, SO_RCVBUF, options.ReceiveBuffer);
+		if (options.Linger >= 0)
+		{
+			linger value{};
+			value.l_onoff = 1;
+			value.l_linger = static_cast<decltype(value.l_linger)>(options.Linger);
+			result &= setsockopt(mSock, SOL_SOCKET, SO_LINGER, reinterpret_cast<const char*>(&value), sizeof(value)) != SOCKET_ERROR;
+		}
+	#ifdef SO_PRIORITY
+		if (options.Priority >= 0)
+			result &= SetOption(mSock, SOL_SOCKET, SO_PRIORITY, options.Priority);
+	#endif
+		SOCKLIB_ASSERT(result, GetError().c_str());
+	}
+
+	void UniqueSocket::Bind(const sockaddr* address, const socklen_t size) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		Unwrap(Check(bind(mSock, address, size)));
+	}
+
+	void UniqueSocket::Bind(const SocketAddress& address) const noexcept { Unwrap(TryBind(address)); }
+
+	Result<void> UniqueSocket::TryBind(const SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Check(bind(mSock, address.Data(), address.Size()));
+	}
+
+	void UniqueSocket::Shutdown(const int how) const noexcept { Unwrap(TryShutdown(how)); }
+
+	Result<void> UniqueSocket::TryShutdown(const int how) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Check(shutdown(mSock, how));
+	}
+
+	void UniqueSocket::Close() noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "The Socket is already closed!");
+		const int result = closesocket(mSock);
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		mSock = INVALID_SOCKET;
+	}
+
+	SOCKET UniqueSocket::Release() noexcept
+	{
+		const SOCKET sock = mSock;
+		mSock = INVALID_SOCKET;
+		return sock;
+	}
+
+	void UniqueSocket::Connect(const sockaddr* address, const socklen_t size) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		Unwrap(ConnectSocket(mSock, address, size));
+	}
+
+	void UniqueSocket::Connect(const SocketAddress& address) const noexcept { Unwrap(TryConnect(address)); }
+
+	Result<void> UniqueSocket::TryConnect(const SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return ConnectSocket(mSock, address.Data(), address.Size());
+	}
+
+	Result<void> UniqueSocket::TryConnect(const SocketAddress& address, const uint32_t timeout, const bool blocking) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		const auto deadline = timeout > 0 ? std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout) : std::chrono::steady_clock::time_point::max();
+		if (blocking)
+			SetBlocking(false);
+
+		Result<void> result = ConnectSocket(mSock, address.Data(), address.Size());
+		if (!result && WouldBlock(result.error()))
+		{
+			//Writability tells that the handshake is over, SO_ERROR tells how it went
+			result = WaitFor(mSock, POLLOUT, deadline);
+			if (result)
+				result = ConnectError(mSock);
+			else if (WouldBlock(result.error()))
+				result = Unexpected(TimedOut());
+		}
+
+		if (blocking)
+			SetBlocking(true);
+		return result;
+	}
+
+	Result<std::pair<UniqueSocket, size_t>> UniqueSocket::TryConnectFirst(const std::span<const SocketAddress> candidates, const uint32_t timeout, const uint32_t stagger) noexcept
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto deadline = timeout > 0 ? Clock::now() + std::chrono::milliseconds(timeout) : Clock::time_point::max();
+		std::error_code error = std::make_error_code(std::errc::invalid_argument);//Only reported if there are no candidates
+
+		//The attempts that are in progress, polled together
+		std::vector<UniqueSocket> attempts;
+		std::vector<pollfd> fds;
+		std::vector<size_t> indices;
+		SocketOptions options;
+		options.NonBlocking = true;
+		size_t next = 0;
+		Clock::time_point nextStart = Clock::now();
+		while (true)
+		{
+			//Start the attempts that are due, the next one is due right away if nothing is in progress
+			while (next < candidates.size() && (fds.empty() || Clock::now() >= nextStart))
+			{
+				const size_t index = next++;
+				nextStart = Clock::now() + std::chrono::milliseconds(stagger);
+				const SocketAddress& address = candidates[index];
+				UniqueSocket sock(CreateSocket(static_cast<int>(address.Family()), static_cast<int>(SocketType::STREAM), IPPROTO_TCP, options));
+				if (sock.mSock == INVALID_SOCKET)
+				{
+					error = LastError();
+					nextStart = Clock::now();
+					continue;
+				}
+				const Result<void> result = ConnectSocket(sock.mSock, address.Data(), address.Size());
+				if (result)
+				{
+					sock.SetBlocking(true);
+					return std::pair<UniqueSocket, size_t>(std::move(sock), index);
+				}
+				if (!WouldBlock(result.error()))
+				{
+					error = result.error();
+					nextStart = Clock::now();//Failed synchronously, the next candidate doesn't wait either
+					continue;
+				}
+				fds.push_back({ sock.mSock, POLLOUT, 0 });
+				attempts.push_back(std::move(sock));
+				indices.push_back(index);
+			}
+			if (fds.empty()) break;
+
+			const auto wake = next < candidates.size() ? std::min(deadline, nextStart) : deadline;
+			if (const Result<void> ready = WaitForAny(fds, wake); !ready)
+			{
+				if (!WouldBlock(ready.error())) return Unexpected(ready.error());
+				if (Clock::now() >= deadline) return Unexpected(TimedOut());
+				continue;//Time for the next attempt
+			}
+
+			//Attempts that finished together are settled in the order of the candidates
+			for (size_t i = 0; i < fds.size();)
+			{
+				if (fds[i].revents == 0)
+				{
+					i++;
+					continue;
+				}
+				const Result<void> result = ConnectError(attempts[i].mSock);
+				if (result)
+				{
+					attempts[i].SetBlocking(true);
+					return std::pair<UniqueSocket, size_t>(std::move(attempts[i]), indices[i]);//The rest are closed on return
+				}
+				error = result.error();
+				nextStart = Clock::now();//A failure starts the next attempt without waiting for the stagger
+				fds.erase(fds.begin() + static_cast<std::ptrdiff_t>(i));
+				attempts.erase(attempts.begin() + static_cast<std::ptrdiff_t>(i));
+				indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+		}
+		return Unexpected(error);
+	}
+
+	void UniqueSocket::Listen(const int length) const noexcept { Unwrap(TryListen(length)); }
+
+	Result<void> UniqueSocket::TryListen(const int length) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Check(listen(mSock, length));
+	}
+
+	UniqueSocket UniqueSocket::Accept(sockaddr* address, socklen_t* size) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Unwrap(AcceptSocket(mSock, address, size));
+	}
+
+	UniqueSocket UniqueSocket::Accept(SocketAddress& address) const noexcept { return Unwrap(TryAccept(address)); }
+
+	Result<UniqueSocket> UniqueSocket::TryAccept() const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return AcceptSocket(mSock, nullptr, nullptr);
+	}
+
+	Result<UniqueSocket> UniqueSocket::TryAccept(SocketAddress& address) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		socklen_t size = SocketAddress::Capacity();
+		Result<UniqueSocket> client = AcceptSocket(mSock, address.Data(), &size);
+		address.Resize(client ? size : 0);
+		return client;
+	}
+
+	Result<size_t> UniqueSocket::AcceptMany(const std::span<Accepted> connections) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		size_t count = 0;
+		size_t aborted = 0;
+		while (count < connections.size())
+		{
+			Accepted& connection = connections[count];
+			socklen_t size = SocketAddress::Capacity();
+			const SOCKET client = AcceptNonBlocking(mSock, connection.Peer.Data(), &size);
+			if (client == INVALID_SOCKET)
+			{
+				const std::error_code error = LastError();
+				if (IsInterrupted(error)) continue;
+				//The next pending connection may be fine, but a batch never skips more than it could hold
+				if (IsAborted(error) && ++aborted <= connections.size()) continue;
+				if (count > 0) break;//The error is reported by the next call, if it persists
+				return Unexpected(error);
+			}
+			connection.Sock = UniqueSocket(client);
+			connection.Peer.Resize(size);
+			count++;
+		}
+		return count;
+	}
+
+	IOSize UniqueSocket::Send(const void* data, const size_t length, const size_t offset) const noexcept { return Unwrap(TrySend(data, length, offset)); }
+
+	Result<size_t> UniqueSocket::TrySend(const void* data, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		const char* buffer = static_cast<const char*>(data) + offset;
+		return Retry([&] { return send(mSock, buffer, length, 0); });
+	}
+
+	IOSize UniqueSocket::SendTo(const void* data, const sockaddr* address, const socklen_t addressSize, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		const char* buffer = static_cast<const char *>(data) + offset;
+		return Unwrap(Retry([&] { return sendto(mSock, buffer, length, 0, address, addressSize); }));
+	}
+
+	IOSize UniqueSocket::SendTo(const void* data, const SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		return Unwrap(TrySendTo(data, address, length, offset));
+	}
+
+	Result<size_t> UniqueSocket::TrySendTo(const void* data, const SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		const char* buffer = static_cast<const char *>(data) + offset;
+		return Retry([&] { return sendto(mSock, buffer, length, 0, address.Data(), address.Size()); });
+	}
+
+	IOSize UniqueSocket::Receive(void* data, const size_t length, const size_t offset) const noexcept { return Unwrap(TryReceive(data, length, offset)); }
+
+	Result<size_t> UniqueSocket::TryReceive(void* data, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		char* buffer = static_cast<char*>(data) + offset;
+		return Retry([&] { return recv(mSock, buffer, length, 0); });
+	}
+
+	IOSize UniqueSocket::ReceiveFrom(void* data, sockaddr* address, socklen_t* addressSize, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		char* buffer = static_cast<char *>(data) + offset;
+		return Unwrap(Retry([&] { return recvfrom(mSock, buffer, length, 0, address, addressSize); }));
+	}
+
+	IOSize UniqueSocket::ReceiveFrom(void* data, SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		return Unwrap(TryReceiveFrom(data, address, length, offset));
+	}
+
+	Result<size_t> UniqueSocket::TryReceiveFrom(void* data, SocketAddress& address, const size_t length, const size_t offset) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		char* buffer = static_cast<char *>(data) + offset;
+		socklen_t size = SocketAddress::Capacity();
+		const Result<size_t> bytes = Retry([&] { return recvfrom(mSock, buffer, length, 0, address.Data(), &size); });
+		address.Resize(bytes ? size : 0);
+		return bytes;
+	}
+
+	IOSize UniqueSocket::SendV(const std::span<const IOBuffer> buffers) const noexcept { return Unwrap(TrySendV(buffers)); }
+
+	IOSize UniqueSocket::ReceiveV(const std::span<const IOBuffer> buffers) const noexcept { return Unwrap(TryReceiveV(buffers)); }
+
+	IOSize UniqueSocket::ReceiveBatch(const std::span<Datagram> datagrams) const noexcept { return Unwrap(TryReceiveBatch(datagrams)); }
+
+	IOSize UniqueSocket::SendBatch(const std::span<Datagram> datagrams) const noexcept { return Unwrap(TrySendBatch(datagrams)); }
+
+	IOSize UniqueSocket::SendFile(const int fd, const uint64_t offset, const size_t count) const noexcept { return Unwrap(TrySendFile(fd, offset, count)); }
+
+	IOSize UniqueSocket::ReceiveToFile(const int fd, const uint64_t offset, const size_t count) const noexcept { return Unwrap(TryReceiveToFile(fd, offset, count)); }
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef PLATFORM_WINDOWS
+	static_assert(sizeof(IOBuffer) == sizeof(WSABUF) && offsetof(IOBuffer, Data) == offsetof(WSABUF, buf), "IOBuffer must match WSABUF!");
+
+	static Result<size_t> SendBuffers(const SOCKET sock, const std::span<const IOBuffer> buffers, const sockaddr* address, const socklen_t addressSize, const int flags = 0) noexcept
+	{
+		auto* native = reinterpret_cast<LPWSABUF>(const_cast<IOBuffer*>(buffers.data()));
+		return Retry([&]
+		{
+			DWORD bytes = 0;
+			const int result = WSASendTo(sock, native, static_cast<DWORD>(buffers.size()), &bytes, static_cast<DWORD>(flags), address, addressSize, nullptr, nullptr);
+			return result == SOCKET_ERROR ? -1 : static_cast<IOSize>(bytes);
+		});
+	}
+
+	static Result<size_t> ReceiveBuffers(const SOCKET sock, const std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize, const int flags = 0) noexcept
+	{
+		auto* native = reinterpret_cast<LPWSABUF>(const_cast<IOBuffer*>(buffers.data()));
+		return Retry([&]
+		{
+			DWORD bytes = 0, inOut = static_cast<DWORD>(flags);
+			const int result = address != nullptr
+				? WSARecvFrom(sock, native, static_cast<DWORD>(buffers.size()), &bytes, &inOut, address, addressSize, nullptr, nullptr)
+				: WSARecv(sock, native, static_cast<DWORD>(buffers.size()), &bytes, &inOut, nullptr, nullptr);
+			return result == SOCKET_ERROR ? -1 : static_cast<IOSize>(bytes);
+		});
+	}
+#else
+	static_assert(sizeof(IOBuffer) == sizeof(iovec) && offsetof(IOBuffer, Length) == offsetof(iovec, iov_len), "IOBuffer must match iovec!");
+
+	static Result<size_t> SendBuffers(const SOCKET sock, const std::span<const IOBuffer> buffers, const sockaddr* address, const socklen_t addressSize, const int flags = 0) noexcept
+	{
+		msghdr message = {};
+		message.msg_name = const_cast<sockaddr*>(address);
+		message.msg_namelen = addressSize;
+		message.msg_iov = reinterpret_cast<iovec*>(const_cast<IOBuffer*>(buffers.data()));
+		message.msg_iovlen = buffers.size();
+		return Retry([&] { return sendmsg(sock, &message, flags); });
+	}
+
+	static Result<size_t> ReceiveBuffers(const SOCKET sock, const std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize, const int flags = 0) noexcept
+	{
+		msghdr message = {};
+		message.msg_name = address;
+		message.msg_namelen = addressSize != nullptr ? *addressSize : 0;
+		message.msg_iov = reinterpret_cast<iovec*>(const_cast<IOBuffer*>(buffers.data()));
+		message.msg_iovlen = buffers.size();
+
+		const Result<size_t> bytes = Retry([&] { return recvmsg(sock, &message, flags); });
+		if (bytes && addressSize != nullptr) *addressSize = message.msg_namelen;
+		return bytes;
+	}
+#endif
+
+	IOSize UniqueSocket::SendToV(const std::span<const IOBuffer> buffers, const sockaddr* address, const socklen_t addressSize) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Unwrap(SendBuffers(mSock, buffers, address, addressSize));
+	}
+
+	Result<size_t> UniqueSocket::TrySendV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return SendBuffers(mSock, buffers, nullptr, 0);
+	}
+
+	IOSize UniqueSocket::ReceiveFromV(const std::span<const IOBuffer> buffers, sockaddr* address, socklen_t* addressSize) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return Unwrap(ReceiveBuffers(mSock, buffers, address, addressSize));
+	}
+
+	Result<size_t> UniqueSocket::TryReceiveV(const std::span<const IOBuffer> buffers) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return ReceiveBuffers(mSock, buffers, nullptr, nullptr);
+	}
+
+	//Upper bound on the buffers of a single vectored call (IOV_MAX on Linux)
+	static constexpr size_t MAX_BUFFERS = 1024;
+
+	//Skips the bytes that were transferred, first is the index of the first buffer that isn't done yet
+	static void Advance(const std::span<IOBuffer> buffers, size_t& first, size_t bytes) noexcept
+	{
+		while (bytes > 0)
+		{
+			IOBuffer& buffer = buffers[first];
+			const size_t step = std::min<size_t>(bytes, buffer.Length);
+			buffer.Data = static_cast<char*>(buffer.Data) + step;
+			buffer.Length -= static_cast<decltype(buffer.Length)>(step);
+			bytes -= step;
+			if (buffer.Length == 0)
+				first++;
+		}
+	}
+
+	//Repeats a vectored transfer until every buffer is done, the socket fails or the deadline passes
+	template<typename Transfer>
+	static Result<void> TransferAll(const SOCKET sock, const std::span<IOBuffer> buffers, const short events, const uint32_t timeout, Transfer&& transfer) noexcept
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		size_t first = 0;
+		while (true)
+		{
+			while (first < buffers.size() && buffers[first].Length == 0)
+				first++;
+			if (first == buffers.size()) return {};
+
+			//With a deadline the calls must not block, the waiting is done by WaitFor
+			if (timeout > 0)
+			{
+				if (const Result<void> ready = WaitFor(sock, events, deadline); !ready)
+					return ready;
+			}
+
+			const std::span<const IOBuffer> pending = buffers.subspan(first, std::min(buffers.size() - first, MAX_BUFFERS));
+			const Result<size_t> bytes = transfer(pending, timeout > 0 ? DONT_WAIT : 0);
+			if (!bytes)
+			{
+				if (timeout > 0 && WouldBlock(bytes.error())) continue;//Readiness can be spurious
+				return Unexpected(bytes.error());
+			}
+			if (*bytes == 0)
+				return Unexpected(std::make_error_code(std::errc::no_message));//Only a receive can get here, the peer shut down
+			Advance(buffers, first, *bytes);
+		}
+	}
+
+	Result<void> UniqueSocket::SendAll(const void* data, const size_t length, const uint32_t timeout) const noexcept
+	{
+		IOBuffer buffer(data, length);
+		return SendAllV({ &buffer, 1 }, timeout);
+	}
+
+	Result<void> UniqueSocket::SendAllV(const std::span<IOBuffer> buffers, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return TransferAll(mSock, buffers, POLLOUT, timeout, [this](const std::span<const IOBuffer> pending, const int flags)
+		{
+			return SendBuffers(mSock, pending, nullptr, 0, flags);
+		});
+	}
+
+	Result<void> UniqueSocket::ReceiveExact(void* data, const size_t length, const uint32_t timeout) const noexcept
+	{
+		IOBuffer buffer(data, length);
+		return ReceiveExactV({ &buffer, 1 }, timeout);
+	}
+
+	Result<void> UniqueSocket::ReceiveExactV(const std::span<IOBuffer> buffers, const uint32_t timeout) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		return TransferAll(mSock, buffers, POLLIN, timeout, [this](const std::span<const IOBuffer> pending, const int flags)
+		{
+			return ReceiveBuffers(mSock, pending, nullptr, nullptr, flags);
+		});
+	}
+
+#ifdef PLATFORM_LINUX
+	//Number of datagrams handed to the kernel with a single system call
+	constexpr size_t BATCH_SIZE = 64;
+
+	Result<size_t> UniqueSocket::TryReceiveBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		mmsghdr messages[BATCH_SIZE];
+		iovec vectors[BATCH_SIZE];
+
+		size_t received = 0;
+		while (received < datagrams.size())
+		{
+			const size_t count = std::min(BATCH_SIZE, datagrams.size() - received);
+			for (size_t i = 0; i < count; i++)
+			{
+				Datagram& datagram = datagrams[received + i];
+				vectors[i] = { datagram.Data, datagram.Length };
+				messages[i].msg_hdr = {};
+				messages[i].msg_hdr.msg_name = datagram.Address.Data();
+				messages[i].msg_hdr.msg_namelen = SocketAddress::Capacity();
+				messages[i].msg_hdr.msg_iov = &vectors[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			//Only wait for the very first datagram, after that take whatever is already queued
+			const int flags = received == 0 ? MSG_WAITFORONE : MSG_DONTWAIT;
+			const int result = recvmmsg(mSock, messages, static_cast<unsigned int>(count), flags, nullptr);
+			if (result == -1)
+			{
+				if (received > 0) break;
+				const std::error_code error = LastError();
+				if (IsInterrupted(error)) continue;
+				return Unexpected(error);
+			}
+
+			for (int i = 0; i < result; i++)
+			{
+				Datagram& datagram = datagrams[received + i];
+				datagram.Bytes = messages[i].msg_len;
+				datagram.Address.Resize(messages[i].msg_hdr.msg_namelen);
+			}
+			received += result;
+			if (static_cast<size_t>(result) < count) break;//Nothing else is queued
+		}
+		return received;
+	}
+
+	Result<size_t> UniqueSocket::TrySendBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		mmsghdr messages[BATCH_SIZE];
+		iovec vectors[BATCH_SIZE];
+
+		size_t sent = 0;
+		while (sent < datagrams.size())
+		{
+			const size_t count = std::min(BATCH_SIZE, datagrams.size() - sent);
+			for (size_t i = 0; i < count; i++)
+			{
+				Datagram& datagram = datagrams[sent + i];
+				vectors[i] = { datagram.Data, datagram.Length };
+				messages[i].msg_hdr = {};
+				messages[i].msg_hdr.msg_name = datagram.Address.Data();
+				messages[i].msg_hdr.msg_namelen = datagram.Address.Size();
+				messages[i].msg_hdr.msg_iov = &vectors[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int result = sendmmsg(mSock, messages, static_cast<unsigned int>(count), 0);
+			if (result == -1)
+			{
+				if (sent > 0) break;
+				const std::error_code error = LastError();
+				if (IsInterrupted(error)) continue;
+				return Unexpected(error);
+			}
+
+			for (int i = 0; i < result; i++)
+				datagrams[sent + i].Bytes = messages[i].msg_len;
+			sent += result;
+			if (static_cast<size_t>(result) < count) break;
+		}
+		return sent;
+	}
+#else
+	Result<size_t> UniqueSocket::TryReceiveBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		if (datagrams.empty()) return 0;
+		Datagram& datagram = datagrams.front();
+		const Result<size_t> bytes = TryReceiveFrom(datagram.Data, datagram.Address, datagram.Length);
+		if (!bytes) return Unexpected(bytes.error());
+		datagram.Bytes = *bytes;
+		return 1;
+	}
+
+	Result<size_t> UniqueSocket::TrySendBatch(const std::span<Datagram> datagrams) const noexcept
+	{
+		size_t sent = 0;
+		for (Datagram& datagram : datagrams)
+		{
+			const Result<size_t> bytes = TrySendTo(datagram.Data, datagram.Address, datagram.Length);
+			if (!bytes)
+			{
+				if (sent > 0) break;
+				return Unexpected(bytes.error());
+			}
+			datagram.Bytes = *bytes;
+			sent++;
+		}
+		return sent;
+	}
+#endif
+
+#ifdef PLATFORM_LINUX
+	Result<size_t> UniqueSocket::TrySendFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		size_t sent = 0;
+		while (sent < count)
+		{
+			off_t position = static_cast<off_t>(offset + sent);
+			const ssize_t bytes = sendfile(mSock, fd, &position, count - sent);
+			if (bytes > 0)
+			{
+				sent += static_cast<size_t>(bytes);
+				continue;
+			}
+			if (bytes == 0) break;//End of file
+
+			const std::error_code error = LastError();
+			if (IsInterrupted(error)) continue;
+			if (sent > 0) break;//Report the progress, the failure shows up again on the next call
+			return Unexpected(error);
+		}
+		return sent;
+	}
+
+	Result<size_t> UniqueSocket::TryReceiveToFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		struct Pipe {
+			int Fds[2] = { -1, -1 };
+			~Pipe() noexcept { if (Fds[0] != -1) { close(Fds[0]); close(Fds[1]); } }
+		} pipe;
+		if (pipe2(pipe.Fds, O_CLOEXEC) == -1) return Unexpected(LastError());
+		fcntl(pipe.Fds[1], F_SETPIPE_SZ, static_cast<int>(MiB));//Fewer round trips if allowed, the default is 64 KiB
+		const int capacity = fcntl(pipe.Fds[1], F_GETPIPE_SZ);
+		const size_t chunk = capacity > 0 ? static_cast<size_t>(capacity) : 64 * KiB;
+
+		//The pipe is empty before every socket to pipe splice, so only the socket can block
+		size_t received = 0;
+		while (received < count)
+		{
+			const ssize_t moved = splice(mSock, nullptr, pipe.Fds[1], nullptr, std::min(count - received, chunk), SPLICE_F_MOVE);
+			if (moved == 0) break;//The peer shut down
+			if (moved == -1)
+			{
+				const std::error_code error = LastError();
+				if (IsInterrupted(error)) continue;
+				if (received > 0) break;
+				return Unexpected(error);
+			}
+
+			//Drain the pipe completely, whatever is left in it when it is closed would be lost
+			size_t pending = static_cast<size_t>(moved);
+			while (pending > 0)
+			{
+				loff_t position = static_cast<loff_t>(offset + received);
+				const ssize_t written = splice(pipe.Fds[0], nullptr, fd, &position, pending, SPLICE_F_MOVE);
+				if (written == 0) return Unexpected(std::make_error_code(std::errc::io_error));
+				if (written == -1)
+				{
+					const std::error_code error = LastError();
+					if (IsInterrupted(error)) continue;
+					return Unexpected(error);
+				}
+				received += static_cast<size_t>(written);
+				pending -= static_cast<size_t>(written);
+			}
+		}
+		return received;
+	}
+#else
+	Result<size_t> UniqueSocket::TrySendFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		char buffer[64 * KiB];
+		size_t sent = 0;
+		while (sent < count)
+		{
+			const IOSize bytes = ReadFileAt(fd, buffer, std::min(count - sent, sizeof(buffer)), offset + sent);
+			if (bytes == 0) break;//End of file
+			if (bytes == -1)
+			{
+				if (sent > 0) break;
+				return Unexpected(std::error_code(errno, std::generic_category()));
+			}
+
+			size_t done = 0;
+			while (done < static_cast<size_t>(bytes))
+			{
+				const Result<size_t> result = TrySend(buffer, static_cast<size_t>(bytes) - done, done);
+				if (!result)
+				{
+					if (sent + done > 0) return sent + done;//The caller continues from this offset
+					return Unexpected(result.error());
+				}
+				done += *result;
+			}
+			sent += done;
+		}
+		return sent;
+	}
+
+	Result<size_t> UniqueSocket::TryReceiveToFile(const int fd, const uint64_t offset, const size_t count) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		char buffer[64 * KiB];
+		size_t received = 0;
+		while (received < count)
+		{
+			const Result<size_t> bytes = TryReceive(buffer, std::min(count - received, sizeof(buffer)));
+			if (!bytes)
+			{
+				if (received > 0) break;
+				return Unexpected(bytes.error());
+			}
+			if (*bytes == 0) break;//The peer shut down
+
+			if (!WriteFileAt(fd, buffer, *bytes, offset + received))
+				return Unexpected(std::error_code(errno, std::generic_category()));
+			received += *bytes;
+		}
+		return received;
+	}
+#endif
+
+	void UniqueSocket::SetBlocking(const bool flag) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		int result = SOCKET_ERROR;
+	#ifdef PLATFORM_WINDOWS
+		unsigned long iMode = (unsigned long)!flag;
+		result = ioctlsocket(mSock, FIONBIO, &iMode);
+	#else
+		//A single system call, rather than reading the flags with fcntl and writing them back
+		int mode = !flag;
+		result = ioctl(mSock, FIONBIO, &mode);
+	#endif
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+	}
+
+	void UniqueSocket::SetTimeout(const uint32_t millis) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+		int result;
+	#ifdef PLATFORM_WINDOWS
+		result = setsockopt(mSock, SOL_SOCKET, SO_SNDTIMEO, (char*)&millis, sizeof(uint32_t));
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		result = setsockopt(mSock, SOL_SOCKET, SO_RCVTIMEO, (char*)&millis, sizeof(uint32_t));
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+	#else
+		timeval timeout{};
+		timeout.tv_sec = static_cast<long>(millis) / 1000;
+		timeout.tv_usec = (static_cast<long>(millis) % 1000)* 1000;
+		result = setsockopt(mSock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeval));
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+		result = setsockopt(mSock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeval));
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+	#endif
+	}
+
+	void UniqueSocket::SetReusePort(const bool flag) const noexcept
+	{
+		SOCKLIB_ASSERT(mSock != INVALID_SOCKET, "Socket is not opened!");
+	#ifdef SO_REUSEPORT
+		const int val = flag ? 1 : 0;
+		const int result = setsockopt(mSock, SOL_SOCKET, SO_REUSEPORT, &val, sizeof(int));
+		SOCKLIB_ASSERT(result != SOCKET_ERROR, GetError().c_str());
+	#else
+		(void)flag;//Windows has no load balancing equivalent
+	#endif
+	}
+
+}
+
+// ********************
+// | Helper functions |
+// ********************
+
+#ifdef PLATFORM_WINDOWS
+	static std::error_code LastError() noexcept { return { WSAGetLastError(), std::system_category() }; }
+
+	static bool IsInterrupted(const std::error_code& error) noexcept { return error.value() == WSAEINTR; }
+
+	static bool IsAborted(const std::error_code& error) noexcept { return error.value() == WSAECONNRESET || error.value() == WSAECONNABORTED; }
+
+	static std::error_code TimedOut() noexcept { return { WSAETIMEDOUT, std::system_category() }; }
+
+	static socklib::SOCKET CreateSocket(const int family, const int type, const int proto, const socklib::SocketOptions& options) noexcept
+	{
+		//Same flags socket() uses, without letting child processes inherit the handle when asked
+		const DWORD flags = WSA_FLAG_OVERLAPPED | (options.CloseOnExec ? WSA_FLAG_NO_HANDLE_INHERIT : 0);
+		const socklib::SOCKET sock = WSASocketW(family, type, proto, nullptr, 0, flags);
+		if (sock == INVALID_SOCKET || !options.NonBlocking) return sock;
+		unsigned long mode = 1;
+		if (ioctlsocket(sock, FIONBIO, &mode) == SOCKET_ERROR)
+		{
+			closesocket(sock);
+			return INVALID_SOCKET;
+		}
+		return sock;
+	}
+
+	//Windows has no accept4, the mode takes a second call
+	static socklib::SOCKET AcceptNonBlocking(const socklib::SOCKET listener, sockaddr* address, socklen_t* size) noexcept
+	{
+		const socklib::SOCKET sock = accept(listener, address, size);
+		if (sock == INVALID_SOCKET) return sock;
+		unsigned long mode = 1;
+		if (ioctlsocket(sock, FIONBIO, &mode) == SOCKET_ERROR)
+		{
+			const int error = WSAGetLastError();
+			closesocket(sock);
+			WSASetLastError(error);
+			return INVALID_SOCKET;
+		}
+		return sock;
+	}
+#else//Unix like platforms
+	static std::error_code LastError() noexcept { return { errno, std::system_category() }; }
+
+	static bool IsInterrupted(const std::error_code& error) noexcept { return error.value() == EINTR; }
+
+	//Connections that were reset while they waited in the backlog, and on Linux the network errors accept4 passes on.
+	//ENOPROTOOPT and EOPNOTSUPP are left out, they are what accept4 reports for a socket that can't listen at all
+	static bool IsAborted(const std::error_code& error) noexcept
+	{
+		switch (error.value())
+		{
+		case ECONNABORTED:
+		case EPROTO:
+	#ifdef PLATFORM_LINUX
+		case ENETDOWN: case EHOSTDOWN: case ENONET: case EHOSTUNREACH: case ENETUNREACH:
+	#endif
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static std::error_code TimedOut() noexcept { return { ETIMEDOUT, std::system_category() }; }
+
+	static socklib::SOCKET CreateSocket(const int family, const int type, const int proto, const socklib::SocketOptions& options) noexcept
+	{
+	#ifdef SOCK_NONBLOCK//Linux and the BSDs take the flags with the type, saving a system call each
+		const int flags = (options.NonBlocking ? SOCK_NONBLOCK : 0) | (options.CloseOnExec ? SOCK_CLOEXEC : 0);
+		return socket(family, type | flags, proto);
+	#else
+		const socklib::SOCKET sock = socket(family, type, proto);
+		if (sock == INVALID_SOCKET) return sock;
+		int mode = 1;
+		if ((options.NonBlocking && ioctl(sock, FIONBIO, &mode) == -1) || (options.CloseOnExec && fcntl(sock, F_SETFD, FD_CLOEXEC) == -1))
+		{
+			const int error = errno;
+			close(sock);
+			errno = error;
+			return INVALID_SOCKET;
+		}
+		return sock;
+	#endif
+	}
+
+	static socklib::SOCKET AcceptNonBlocking(const socklib::SOCKET listener, sockaddr* address, socklen_t* size) noexcept
+	{
+	#ifdef SOCK_NONBLOCK//accept4 sets the flags of the new socket in the same system call
+		return accept4(listener, address, size, SOCK_NONBLOCK | SOCK_CLOEXEC);
+	#else
+		const socklib::SOCKET sock = accept(listener, address, size);
+		if (sock == INVALID_SOCKET) return sock;
+		int mode = 1;
+		if (ioctl(sock, FIONBIO, &mode) == -1 || fcntl(sock, F_SETFD, FD_CLOEXEC) == -1)
+		{
+			const int error = errno;
+			close(sock);
+			errno = error;
+			return INVALID_SOCKET;
+		}
+		return sock;
+	#endif
+	}
+#endif
+
+static bool SetOption(const socklib::SOCKET sock, const int level, const int name, const int value) noexcept
+{
+	return setsockopt(sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) != SOCKET_ERROR;
+}
+
+//Waits until the socket is ready for the events, fails like an expired SO_RCVTIMEO/SO_SNDTIMEO once the deadline passes
+static socklib::Result<void> WaitFor(const socklib::SOCKET sock, const short events, const std::chrono::steady_clock::time_point deadline) noexcept
+{
+	pollfd fd = { sock, events, 0 };
+	return WaitForAny({ &fd, 1 }, deadline);
+}
+
+//Waits until any of the sockets is ready, revents tells which ones
+static socklib::Result<void> WaitForAny(const std::span<pollfd> fds, const std::chrono::steady_clock::time_point deadline) noexcept
+{
+	while (true)
+	{
+		const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+	#ifdef PLATFORM_WINDOWS
+		if (remaining <= 0) return socklib::Unexpected(std::error_code(WSAETIMEDOUT, std::system_category()));
+		const int result = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), static_cast<INT>(std::min<long long>(remaining, INT_MAX)));
+	#else
+		if (remaining <= 0) return socklib::Unexpected(std::error_code(EAGAIN, std::system_category()));
+		const int result = poll(fds.data(), static_cast<nfds_t>(fds.size()), static_cast<int>(std::min<long long>(remaining, INT_MAX)));
+	#endif
+		if (result > 0) return {};//Errors and hang ups are reported by the next transfer
+		if (result == SOCKET_ERROR)
+		{
+			const std::error_code error = LastError();
+			if (!IsInterrupted(error)) return socklib::Unexpected(error);
+		}
+	}
+}
+
+//Outcome of a non-blocking connect once the socket is writable (or failed)
+static socklib::Result<void> ConnectError(const socklib::SOCKET sock) noexcept
+{
+	int error = 0;
+	socklen_t size = sizeof(error);
+	if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == SOCKET_ERROR)
+		return socklib::Unexpected(LastError());
+	if (error != 0)
+		return socklib::Unexpected(std::error_code(error, std::system_category()));
+	return {};
+}
+
+#if defined(PLATFORM_WINDOWS)
+	static socklib::IOSize ReadFileAt(const int fd, void* data, const size_t length, const uint64_t offset) noexcept
+	{
+		if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) == -1) return -1;
+		return _read(fd, data, static_cast<unsigned int>(length));
+	}
+
+	static bool WriteFileAt(const int fd, const void* data, const size_t length, const uint64_t offset) noexcept
+	{
+		if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) == -1) return false;
+		return _write(fd, data, static_cast<unsigned int>(length)) == static_cast<int>(length);
+	}
+#elif !defined(PLATFORM_LINUX)
+	static socklib::IOSize ReadFileAt(const int fd, void* data, const size_t length, const uint64_t offset) noexcept
+	{
+		ssize_t bytes;
+		do
+		{
+			bytes = pread(fd, data, length, static_cast<off_t>(offset));
+		} while (bytes == -1 && errno == EINTR);
+		return bytes;
+	}
+
+	static bool WriteFileAt(const int fd, const void* data, size_t length, uint64_t offset) noexcept
+	{
+		const char* buffer = static_cast<const char*>(data);
+		while (length > 0)
+		{
+			const ssize_t bytes = pwrite(fd, buffer, length, static_cast<off_t>(offset));
+			if (bytes == -1)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			buffer += bytes;
+			length -= static_cast<size_t>(bytes);
+			offset += static_cast<uint64_t>(bytes);
+		}
+		return true;
+	}
+#endif
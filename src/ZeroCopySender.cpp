@@ -0,0 +1,158 @@
+#include <socklib/ZeroCopySender.h>
+#include <chrono>
+#include <vector>
+#if defined(PLATFORM_LINUX) && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+	#include <linux/errqueue.h>
+	#include <netinet/in.h>
+	#define SOCKLIB_ZEROCOPY
+#endif
+
+//Declaration of helper functions
+std::string GetError() noexcept;
+//End Declaration of helper functions
+
+namespace socklib {
+
+	size_t ZeroCopySender::Complete(const uint32_t first, const uint32_t last) noexcept
+	{
+		//Take the callbacks out first, they are allowed to Send again
+		std::vector<Callback> finished;
+		for (auto it = mPending.begin(); it != mPending.end();)
+		{
+			if (it->Id - first <= last - first)//Wraps around like the kernel's counter
+			{
+				finished.push_back(std::move(it->Done));
+				it = mPending.erase(it);
+			}
+			else
+				++it;
+		}
+
+		for (const Callback& done : finished)
+		{
+			if (done)
+				done();
+		}
+		return finished.size();
+	}
+
+	// ************************************************************************
+	// | Bellow from here the implementation differ depending on the Platform |
+	// ************************************************************************
+
+#ifdef SOCKLIB_ZEROCOPY
+	ZeroCopySender::ZeroCopySender(Socket sock, const size_t threshold) noexcept
+		: mSock(std::move(sock)), mThreshold(threshold)
+	{
+		SOCKLIB_ASSERT(mSock.FileNo() != INVALID_SOCKET, "Socket is not opened!");
+		constexpr int flag = 1;
+		mEnabled = setsockopt(mSock.FileNo(), SOL_SOCKET, SO_ZEROCOPY, &flag, sizeof(int)) == 0;
+	}
+
+	Result<size_t> ZeroCopySender::Send(const void* data, const size_t length, Callback done) noexcept
+	{
+		if (mEnabled && length >= mThreshold)
+		{
+			ssize_t bytes;
+			do
+			{
+				bytes = send(mSock.FileNo(), data, length, MSG_ZEROCOPY);
+			} while (bytes == -1 && errno == EINTR);
+
+			if (bytes != -1)
+			{
+				mPending.push_back({ mNextId++, std::move(done) });
+				mStats.ZeroCopy++;
+				return static_cast<size_t>(bytes);
+			}
+			if (errno != ENOBUFS)//Out of optmem to pin the pages, copying still works
+				return Unexpected(std::error_code(errno, std::system_category()));
+		}
+
+		const Result<size_t> bytes = mSock.TrySend(data, length);
+		if (!bytes) return bytes;
+		mStats.Fallback++;
+		if (done)
+			done();
+		return bytes;
+	}
+
+	size_t ZeroCopySender::ProcessCompletions() noexcept
+	{
+		size_t completed = 0;
+		while (!mPending.empty())
+		{
+			char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+			msghdr message{};
+			message.msg_control = control;
+			message.msg_controllen = sizeof(control);
+			if (recvmsg(mSock.FileNo(), &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+			{
+				if (errno == EINTR) continue;
+				break;//EAGAIN: no more notifications
+			}
+
+			for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+			{
+				const bool v4 = cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR;
+				const bool v6 = cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR;
+				if (!v4 && !v6) continue;
+
+				const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+				if (error->ee_origin != SO_EE_ORIGIN_ZEROCOPY || error->ee_errno != 0) continue;
+
+				//The notification covers the inclusive range of ids [ee_info, ee_data]
+				if (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+					mStats.Copied += error->ee_data - error->ee_info + 1;
+				completed += Complete(error->ee_info, error->ee_data);
+			}
+		}
+		return completed;
+	}
+
+	bool ZeroCopySender::WaitForCompletions(const int32_t millis) noexcept
+	{
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(millis);
+		while (true)
+		{
+			ProcessCompletions();
+			if (mPending.empty()) return true;
+
+			int32_t timeout = -1;
+			if (millis >= 0)
+			{
+				const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+				if (remaining <= 0) return false;
+				timeout = static_cast<int32_t>(remaining);
+			}
+
+			//Pending notifications in the error queue are always reported as POLLERR
+			pollfd fd{ mSock.FileNo(), 0, 0 };
+			const int result = poll(&fd, 1, timeout);
+			SOCKLIB_ASSERT(result != -1 || errno == EINTR, GetError().c_str());
+		}
+	}
+#else
+	ZeroCopySender::ZeroCopySender(Socket sock, const size_t threshold) noexcept
+		: mSock(std::move(sock)), mThreshold(threshold)
+	{
+		SOCKLIB_ASSERT(mSock.FileNo() != INVALID_SOCKET, "Socket is not opened!");
+	}
+
+	Result<size_t> ZeroCopySender::Send(const void* data, const size_t length, Callback done) noexcept
+	{
+		const Result<size_t> bytes = mSock.TrySend(data, length);
+		if (!bytes) return bytes;
+		mStats.Fallback++;
+		if (done)
+			done();
+		return bytes;
+	}
+
+	size_t ZeroCopySender::ProcessCompletions() noexcept { return 0; }
+
+	bool ZeroCopySender::WaitForCompletions(int32_t) noexcept { return true; }
+#endif
+
+}
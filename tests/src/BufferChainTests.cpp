@@ -0,0 +1,122 @@
+#include <catch.hpp>
+
+#include <socklib/BufferChain.h>
+
+#include <cstring>
+#include <deque>
+#include <future>
+#include <vector>
+using namespace socklib;
+
+//Bytes of a chain, in order
+static std::vector<BYTE> Flatten(const BufferChain& chain)
+{
+	std::vector<BYTE> bytes;
+	for (const BufferChain::Segment& segment : chain.Segments())
+		bytes.insert(bytes.end(), segment.Data(), segment.Data() + segment.Length);
+	return bytes;
+}
+
+TEST_CASE("Testing BufferChain", "[BufferChain]")
+{
+	const char header[] = "HEAD";
+	const char body[] = "body of the message";
+	BufferChain chain = BufferChain::Copy(header, 4);
+	const BufferChain tail = BufferChain::Copy(body, strlen(body));
+	chain.Append(tail);
+	REQUIRE(chain.Size() == 4 + strlen(body));
+	REQUIRE(chain.Segments().size() == 2);
+	REQUIRE(Flatten(chain) == std::vector<BYTE>({ 'H', 'E', 'A', 'D', 'b', 'o', 'd', 'y', ' ', 'o', 'f', ' ', 't', 'h', 'e', ' ', 'm', 'e', 's', 's', 'a', 'g', 'e' }));
+
+	//Appending and slicing share the memory
+	REQUIRE(chain.Segments()[1].Data() == tail.Segments()[0].Data());
+	REQUIRE(tail.Segments()[0].Buffer.UseCount() == 2);
+	const BufferChain slice = chain.Slice(2, 6);
+	REQUIRE(slice.Size() == 6);
+	REQUIRE(Flatten(slice) == std::vector<BYTE>({ 'A', 'D', 'b', 'o', 'd', 'y' }));
+	REQUIRE(slice.Segments()[1].Data() == tail.Segments()[0].Data());
+	REQUIRE(chain.Slice(20, 100).Size() == chain.Size() - 20);
+	REQUIRE(chain.Slice(100, 1).Empty());
+
+	//Payloads past the largest size class are split
+	std::vector<BYTE> large(3 * MiB + 5, 0x5A);
+	const BufferChain big = BufferChain::Copy(large.data(), large.size());
+	REQUIRE(big.Segments().size() == 4);
+	REQUIRE(Flatten(big) == large);
+
+	IOBuffer buffers[2];
+	REQUIRE(big.Fill(MiB + 1, buffers) == 2);
+	REQUIRE(buffers[0].Length == MiB - 1);
+	REQUIRE(buffers[1].Length == MiB);
+}
+
+TEST_CASE("Testing SendQueue fan-out", "[BufferChain]")
+{
+	static constexpr size_t subscribers = 3;
+	static constexpr size_t size = 512 * KiB;
+	std::vector<BYTE> payload(size);
+	for (size_t i = 0; i < size; i++)
+		payload[i] = static_cast<BYTE>(i * 7 + i / 251);
+
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55945 });
+	std::vector<Socket> clients;
+	std::deque<SendQueue> queues;
+	for (size_t i = 0; i < subscribers; i++)
+	{
+		clients.push_back(Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55945 }));
+		Socket peer = server.Accept().first;
+		peer.SetBlocking(false);
+		queues.emplace_back(peer);
+	}
+
+	//One copy of the payload, queued on every socket behind a header of its own
+	PooledBuffer memory;
+	{
+		BufferChain message = BufferChain::Copy(payload.data(), size);
+		memory = message.Segments()[0].Buffer;
+		for (size_t i = 0; i < subscribers; i++)
+		{
+			const BYTE id = static_cast<BYTE>(i);
+			BufferChain framed = BufferChain::Copy(&id, 1);
+			framed.Append(message);
+			queues[i].Push(std::move(framed));
+		}
+	}
+	REQUIRE(memory.UseCount() == subscribers + 1);
+
+	std::vector<std::future<std::vector<BYTE>>> readers;
+	for (Socket& client : clients)
+	{
+		readers.push_back(std::async(std::launch::async, [&client]()
+		{
+			std::vector<BYTE> received(size + 1);
+			return client.ReceiveExact(received.data(), received.size(), 10000) ? received : std::vector<BYTE>();
+		}));
+	}
+
+	//The sockets take the payload in partial sends, the memory stays alive until the last one is done
+	const auto start = std::chrono::steady_clock::now();
+	bool drained = false;
+	while (!drained && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+	{
+		drained = true;
+		for (SendQueue& queue : queues)
+		{
+			if (queue.Empty()) continue;
+			const Result<size_t> sent = queue.Send();
+			REQUIRE((sent || WouldBlock(sent.error())));
+			drained = drained && queue.Empty();
+		}
+	}
+	REQUIRE(drained);
+	REQUIRE(queues[0].Pending() == 0);
+	REQUIRE(memory.UseCount() == 1);
+
+	for (size_t i = 0; i < subscribers; i++)
+	{
+		const std::vector<BYTE> received = readers[i].get();
+		REQUIRE(received.size() == size + 1);
+		REQUIRE(received[0] == i);
+		REQUIRE(std::equal(payload.begin(), payload.end(), received.begin() + 1));
+	}
+}
@@ -0,0 +1,113 @@
+#include <catch.hpp>
+
+#include <socklib/BufferPool.h>
+
+#include <thread>
+#include <vector>
+using namespace socklib;
+
+TEST_CASE("Testing BufferPool", "[BufferPool]")
+{
+	const BufferPool::Stats before = BufferPool::GetStats();
+
+	//Requests are rounded up to a size class
+	PooledBuffer buffer = BufferPool::Acquire(1000);
+	REQUIRE(buffer.IsValid());
+	REQUIRE(buffer.Size() == 2 * KiB);
+	REQUIRE(reinterpret_cast<uintptr_t>(buffer.Data()) % 64 == 0);
+	REQUIRE(BufferPool::Acquire(16 * KiB + 1).Size() == 64 * KiB);
+	REQUIRE(BufferPool::GetStats().Outstanding - before.Outstanding == static_cast<int64_t>(2 * KiB));
+
+	//Copies share the memory
+	buffer.Data()[0] = 0x42;
+	PooledBuffer copy = buffer;
+	REQUIRE(copy.Data() == buffer.Data());
+	REQUIRE(buffer.UseCount() == 2);
+	const BYTE* memory = buffer.Data();
+	buffer.Reset();
+	REQUIRE(!buffer.IsValid());
+	REQUIRE(copy.UseCount() == 1);
+	REQUIRE(copy.Data()[0] == 0x42);
+
+	//The last handle returns the buffer to the cache of the thread, where the next request finds it
+	copy.Reset();
+	const BufferPool::Stats released = BufferPool::GetStats();
+	REQUIRE(released.Outstanding == before.Outstanding);
+	const PooledBuffer reused = BufferPool::Acquire(2 * KiB);
+	REQUIRE(reused.Data() == memory);
+	REQUIRE(BufferPool::GetStats().Hits == released.Hits + 1);
+
+	//Requests past the largest class are allocated on their own
+	const BufferPool::Stats beforeLarge = BufferPool::GetStats();
+	PooledBuffer large = BufferPool::Acquire(3 * MiB);
+	REQUIRE(large.Size() == 3 * MiB);
+	REQUIRE(BufferPool::GetStats().Misses == beforeLarge.Misses + 1);
+	large.Reset();
+	REQUIRE(BufferPool::GetStats().Cached == beforeLarge.Cached);
+}
+
+TEST_CASE("Testing BufferPool across threads", "[BufferPool]")
+{
+	static constexpr size_t count = 1000;
+	const BufferPool::Stats before = BufferPool::GetStats();
+
+	//Buffers acquired on one thread and released on another, more than a single cache can hold
+	std::vector<PooledBuffer> buffers;
+	std::thread producer([&buffers]()
+	{
+		for (size_t i = 0; i < count; i++)
+			buffers.push_back(BufferPool::Acquire(16 * KiB));
+	});
+	producer.join();
+	REQUIRE(BufferPool::GetStats().Outstanding - before.Outstanding == static_cast<int64_t>(count * 16 * KiB));
+	buffers.clear();
+
+	const BufferPool::Stats after = BufferPool::GetStats();
+	REQUIRE(after.Outstanding == before.Outstanding);
+	REQUIRE(after.Hits + after.Misses - before.Hits - before.Misses == count);
+	REQUIRE(after.Cached - before.Cached == static_cast<int64_t>(count * 16 * KiB));
+
+	//The spilled buffers are picked up by other threads (some stay in the cache of this one)
+	std::thread consumer([]()
+	{
+		const BufferPool::Stats start = BufferPool::GetStats();
+		std::vector<PooledBuffer> buffers;
+		for (size_t i = 0; i < count / 2; i++)
+			buffers.push_back(BufferPool::Acquire(16 * KiB));
+		REQUIRE(BufferPool::GetStats().Misses == start.Misses);
+	});
+	consumer.join();
+
+	BufferPool::Trim();
+	REQUIRE(BufferPool::GetStats().Cached < after.Cached);
+}
+
+TEST_CASE("Testing BufferPool arenas", "[BufferPool]")
+{
+	const BufferPool::Stats before = BufferPool::GetStats();
+
+	//The arena is rounded up to whole huge pages, all of it becoming buffers
+	const Result<ArenaPages> pages = BufferPool::Reserve(2 * KiB, 100);
+	REQUIRE(pages.has_value());
+	const BufferPool::Stats reserved = BufferPool::GetStats();
+	REQUIRE(reserved.Reserved - before.Reserved == static_cast<int64_t>(2 * MiB));
+	REQUIRE(reserved.Cached - before.Cached >= static_cast<int64_t>(100 * 2 * KiB));
+	REQUIRE(reserved.Outstanding == before.Outstanding);
+
+	//A thread with an empty cache is served from the arena
+	std::thread([]()
+	{
+		const BufferPool::Stats start = BufferPool::GetStats();
+		const PooledBuffer buffer = BufferPool::Acquire(1500);
+		REQUIRE(buffer.Size() == 2 * KiB);
+		REQUIRE(reinterpret_cast<uintptr_t>(buffer.Data()) % 64 == 0);
+		REQUIRE(BufferPool::GetStats().Hits == start.Hits + 1);
+	}).join();
+
+	//Trimming keeps the buffers of the arena
+	BufferPool::Trim();
+	REQUIRE(BufferPool::GetStats().Cached >= static_cast<int64_t>(100 * 2 * KiB));
+
+	REQUIRE(BufferPool::Reserve(2 * MiB, 1).error() == std::errc::invalid_argument);
+	REQUIRE(BufferPool::Reserve(2 * KiB, 0).error() == std::errc::invalid_argument);
+}
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+
+#include <socklib/BufferedReader.h>
+
+#include <string_view>
+#include <vector>
+using namespace socklib;
+
+static std::string_view View(const std::span<const BYTE> bytes)
+{
+	return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+}
+
+//Repeats a call on a non-blocking reader until the bytes it needs have arrived
+template<typename Call>
+static auto Poll(Call call)
+{
+	auto result = call();
+	while (!result && WouldBlock(result.error()))
+		result = call();
+	return result;
+}
+
+TEST_CASE("Testing BufferedReader", "[BufferedReader]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55895 });
+	const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55895 });
+	const Socket sock = server.Accept().first;
+
+	constexpr std::string_view request = "GET / HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nHello";
+	REQUIRE(client.Send(request.data(), request.size()) == request.size());
+	client.Shutdown(SHUT_WR);
+
+	BufferedReader reader(sock);
+	REQUIRE(reader.IsValid());
+	REQUIRE(View(reader.ReadUntil("\r\n").value()) == "GET / HTTP/1.1\r\n");
+	REQUIRE(reader.Receives() == 1);//Everything arrived with the first receive
+	REQUIRE(View(reader.Peek(4).value()) == "Host");
+	REQUIRE(View(reader.ReadUntil("\r\n").value()) == "Host: localhost\r\n");
+	REQUIRE(View(reader.ReadUntil("\r\n").value()) == "Content-Length: 5\r\n");
+	REQUIRE(View(reader.ReadUntil("\r\n").value()) == "\r\n");
+	REQUIRE(View(reader.ReadExact(5).value()) == "Hello");
+	REQUIRE(reader.Buffered() == 0);
+	REQUIRE(reader.Receives() == 1);
+
+	//The peer is done, so there won't be another frame
+	const Result<std::span<const BYTE>> end = reader.ReadExact(1);
+	REQUIRE(!end);
+	REQUIRE(end.error() == std::errc::no_message);
+	REQUIRE(reader.IsEndOfStream());
+	char byte;
+	REQUIRE(reader.Read(&byte, 1).value_or(1) == 0);
+
+	const Result<std::span<const BYTE>> tooLarge = reader.Peek(reader.Buffered() + 2 * BufferedReader::DEFAULT_CAPACITY);
+	REQUIRE(!tooLarge);
+	REQUIRE(tooLarge.error() == std::errc::message_size);
+}
+
+TEST_CASE("Testing non-blocking BufferedReader", "[BufferedReader]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55905 });
+	const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55905 });
+	Socket sock = server.Accept().first;
+	sock.SetBlocking(false);
+
+	BufferedReader reader(sock, 1);//Rounded up to a page
+	Result<std::span<const BYTE>> line = reader.ReadUntil("\r\n");
+	REQUIRE(!line);
+	REQUIRE(WouldBlock(line.error()));
+
+	//The delimiter is split across two receives
+	REQUIRE(client.Send("partial\r", 8) == 8);
+	while (reader.Buffered() < 8)
+	{
+		line = reader.ReadUntil("\r\n");
+		REQUIRE(!line);
+		REQUIRE(WouldBlock(line.error()));
+	}
+
+	REQUIRE(client.Send("\nnext", 5) == 5);
+	line = Poll([&] { return reader.ReadUntil("\r\n"); });
+	REQUIRE(View(line.value()) == "partial\r\n");
+	REQUIRE(reader.Buffered() == 4);
+
+	//Frames larger than what is buffered keep the bytes that already arrived
+	const std::vector<char> payload(3000, 'x');
+	REQUIRE(client.Send(payload.data(), payload.size()) == payload.size());
+	const Result<std::span<const BYTE>> frame = Poll([&] { return reader.ReadExact(4 + payload.size()); });
+	REQUIRE(frame.value().size() == 4 + payload.size());
+	REQUIRE(View(frame.value()).substr(0, 5) == "nextx");
+
+	//A line that can't fit into the buffer is reported instead of waiting forever
+	const std::vector<char> longLine(reader.Capacity(), 'y');
+	REQUIRE(client.Send(longLine.data(), longLine.size()) == longLine.size());
+	line = Poll([&] { return reader.ReadUntil("\n"); });
+	REQUIRE(!line);
+	REQUIRE(line.error() == std::errc::message_size);
+}
@@ -0,0 +1,115 @@
+#include <catch.hpp>
+
+#include <socklib/BufferedWriter.h>
+
+#include <algorithm>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace socklib;
+
+static bool ReceiveAll(const Socket& sock, std::vector<BYTE>& data, const size_t length)
+{
+	data.resize(length);
+	size_t received = 0;
+	while (received < length)
+	{
+		const IOSize bytes = sock.Receive(data.data(), length - received, received);
+		if (bytes <= 0) return false;
+		received += bytes;
+	}
+	return true;
+}
+
+TEST_CASE("Testing BufferedWriter", "[BufferedWriter]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55915 });
+	const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55915 });
+	const Socket sock = server.Accept().first;
+
+	BufferedWriterOptions options;
+	options.Threshold = KiB;
+	options.Cork = true;
+	BufferedWriter writer(client, options);
+
+	//Small writes are coalesced until the threshold
+	std::vector<BYTE> expected;
+	for (BYTE i = 0; i < 15; i++)
+	{
+		const std::vector<BYTE> message(64, i);
+		REQUIRE(writer.Write(message.data(), message.size()));
+		expected.insert(expected.end(), message.begin(), message.end());
+	}
+	REQUIRE(writer.Sends() == 0);
+	REQUIRE(writer.Buffered() == 15 * 64);
+
+	const std::vector<BYTE> last(64, 15);
+	REQUIRE(writer.Write(last.data(), last.size()));
+	expected.insert(expected.end(), last.begin(), last.end());
+	REQUIRE(writer.Sends() == 1);
+	REQUIRE(writer.Buffered() == 0);
+
+	//Large writes are sent together with the buffered bytes
+	const std::vector<BYTE> small(10, 0xAA), large(4 * KiB, 0xBB);
+	REQUIRE(writer.Write(small.data(), small.size()));
+	REQUIRE(writer.Write(large.data(), large.size()));
+	expected.insert(expected.end(), small.begin(), small.end());
+	expected.insert(expected.end(), large.begin(), large.end());
+	REQUIRE(writer.Sends() == 2);
+	REQUIRE(writer.Buffered() == 0);
+
+	REQUIRE(writer.Write("tail", 4));
+	expected.insert(expected.end(), { 't', 'a', 'i', 'l' });
+	REQUIRE(writer.Flush());
+	REQUIRE(writer.Sends() == 3);
+
+	std::vector<BYTE> received;
+	REQUIRE(ReceiveAll(sock, received, expected.size()));
+	REQUIRE(received == expected);
+}
+
+TEST_CASE("Testing BufferedWriter delay", "[BufferedWriter]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55925 });
+	Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55925 });
+	const Socket sock = server.Accept().first;
+
+	BufferedWriterOptions options;
+	options.Delay = std::chrono::milliseconds(5);
+	BufferedWriter writer(client, options);
+
+	REQUIRE(writer.Write("one", 3));
+	REQUIRE(writer.FlushIfDue());
+	REQUIRE(writer.Sends() == 0);
+	REQUIRE(writer.Deadline() > std::chrono::steady_clock::now());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	REQUIRE(writer.Write("two", 3));//The first byte waited long enough
+	REQUIRE(writer.Sends() == 1);
+
+	std::vector<BYTE> received;
+	REQUIRE(ReceiveAll(sock, received, 6));
+	REQUIRE(std::string(received.begin(), received.end()) == "onetwo");
+
+	//On a non-blocking socket whatever doesn't fit stays buffered
+	client.SetBlocking(false);
+	const std::vector<BYTE> chunk(64 * KiB, 0x5A);
+	size_t written = 0;
+	while (writer.Buffered() == 0)
+	{
+		REQUIRE(writer.Write(chunk.data(), chunk.size()));
+		written += chunk.size();
+	}
+	const Result<void> flushed = writer.Flush();
+	REQUIRE(!flushed);
+	REQUIRE(WouldBlock(flushed.error()));
+
+	auto reader = std::async(std::launch::async, [&]() { return ReceiveAll(sock, received, written); });
+	Result<void> result = writer.Flush();
+	while (!result && WouldBlock(result.error()))
+		result = writer.Flush();
+	REQUIRE(result);
+	REQUIRE(reader.get());
+	REQUIRE(std::count(received.begin(), received.end(), 0x5A) == static_cast<std::ptrdiff_t>(written));
+}
@@ -0,0 +1,146 @@
+#include <catch.hpp>
+
+#include <socklib/ConnectionPool.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+using namespace socklib;
+
+TEST_CASE("Testing ConnectionPool", "[ConnectionPool]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56015 });
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 56015);
+	ConnectionPoolOptions options;
+	options.MaxIdle = 2;
+	options.MaxTotal = 3;
+	ConnectionPool pool(options);
+
+	//A released connection is handed out again
+	SOCKET first;
+	{
+		Result<PooledConnection> connection = pool.Acquire(address);
+		REQUIRE(connection.has_value());
+		REQUIRE(!connection->IsReused());
+		first = connection->GetSocket().FileNo();
+	}
+	REQUIRE(pool.Idle(address) == 1);
+	{
+		Result<PooledConnection> connection = pool.Acquire(address);
+		REQUIRE(connection.has_value());
+		REQUIRE(connection->IsReused());
+		REQUIRE(connection->GetSocket().FileNo() == first);
+		REQUIRE(pool.GetStats().Hits == 1);
+		REQUIRE(pool.GetStats().Misses == 1);
+
+		//Discarded connections are closed
+		connection->Discard();
+		REQUIRE(!connection->IsValid());
+		REQUIRE(pool.Total(address) == 0);
+	}
+
+	{//The limits apply per endpoint
+		std::vector<PooledConnection> connections;
+		for (size_t i = 0; i < options.MaxTotal; i++)
+			connections.push_back(std::move(pool.Acquire(address).value()));
+		const Result<PooledConnection> denied = pool.Acquire(address);
+		REQUIRE(!denied);
+		REQUIRE(WouldBlock(denied.error()));
+		REQUIRE(pool.Acquire(SocketAddress::Parse("127.0.0.1", 1)).error() == std::errc::connection_refused);
+		REQUIRE(pool.Total(SocketAddress::Parse("127.0.0.1", 1)) == 0);
+		REQUIRE(pool.Endpoints() == 1);//Nothing is kept for the refused one
+	}
+	REQUIRE(pool.Idle(address) == options.MaxIdle);
+	REQUIRE(pool.Total(address) == options.MaxIdle);
+
+	//Idle connections the peer closed fail the health check and are replaced
+	Socket listener = server;
+	listener.SetBlocking(false);
+	while (listener.TryAccept())
+		continue;//Every accepted peer is closed right away
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));//Let the FINs arrive
+	const ConnectionPool::Stats before = pool.GetStats();
+	Result<PooledConnection> fresh = pool.Acquire(address);
+	REQUIRE(fresh.has_value());
+	REQUIRE(!fresh->IsReused());
+	REQUIRE(pool.GetStats().Evicted == before.Evicted + options.MaxIdle);
+	REQUIRE(pool.Total(address) == 1);
+}
+
+TEST_CASE("Testing ConnectionPool idle eviction & warm-up", "[ConnectionPool]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56025 });
+	const Socket other = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56035 });
+	const SocketAddress addresses[] = { SocketAddress::Parse("127.0.0.1", 56025), SocketAddress::Parse("127.0.0.1", 56035) };
+	ConnectionPoolOptions options;
+	options.MaxIdle = 4;
+	options.IdleTimeout = std::chrono::milliseconds(50);
+	ConnectionPool pool(options);
+
+	//Every endpoint gets its connections at once, limited by MaxIdle
+	REQUIRE(pool.WarmUp(addresses, 6, 1000) == 2 * options.MaxIdle);
+	REQUIRE(pool.Idle(addresses[0]) == options.MaxIdle);
+	REQUIRE(pool.Idle(addresses[1]) == options.MaxIdle);
+	REQUIRE(pool.WarmUp(addresses, 1) == 0);
+	REQUIRE(pool.Acquire(addresses[1])->IsReused());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(pool.EvictIdle() == 2 * options.MaxIdle);
+	REQUIRE(pool.Total(addresses[0]) == 0);
+	REQUIRE(pool.Total(addresses[1]) == 0);
+
+	//Attempts that fail give their slots back
+	const SocketAddress refused = SocketAddress::Parse("127.0.0.1", 1);
+	REQUIRE(pool.WarmUp({ &refused, 1 }, 2, 1000) == 0);
+	REQUIRE(pool.Total(refused) == 0);
+	REQUIRE(pool.Endpoints() == 0);
+}
+
+TEST_CASE("Testing ConnectionPool across threads", "[ConnectionPool]")
+{
+	static constexpr size_t threads = 4;
+	static constexpr size_t leases = 500;
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56045 });
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 56045);
+	ConnectionPool pool;
+
+	std::atomic<size_t> failures = 0;
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < threads; i++)
+	{
+		workers.emplace_back([&pool, &address, &failures]()
+		{
+			for (size_t lease = 0; lease < leases; lease++)
+			{
+				if (!pool.Acquire(address))
+					failures++;
+			}
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	REQUIRE(failures == 0);
+	const ConnectionPool::Stats stats = pool.GetStats();
+	REQUIRE(stats.Hits + stats.Misses == threads * leases);
+	REQUIRE(stats.Misses <= threads);
+	REQUIRE(pool.Total(address) == pool.Idle(address));
+}
+
+TEST_CASE("Testing ConnectionPool leases released on other threads", "[ConnectionPool]")
+{
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56105 });
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 56105);
+	ConnectionPoolOptions options;
+	options.MaxIdle = 1;
+	options.MaxTotal = 1;
+	ConnectionPool pool(options);
+
+	//The connection is kept in the shard of the thread that released it, the others still find it
+	std::thread([&pool, &address]() { REQUIRE(pool.Acquire(address).has_value()); }).join();
+	REQUIRE(pool.Idle(address) == 1);
+	Result<PooledConnection> connection = pool.Acquire(address);
+	REQUIRE(connection.has_value());
+	REQUIRE(connection->IsReused());
+	REQUIRE(pool.Total(address) == 1);
+}
@@ -0,0 +1,139 @@
+#include <catch.hpp>
+
+#include <future>
+
+#include <socklib/IOEngine.h>
+
+#include <thread>
+using namespace socklib;
+
+static void RunEchoServer(IOEngine& engine, const unsigned short port)
+{
+	static constexpr size_t clients = 8;
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", port });
+	REQUIRE(engine.ProvideBuffers(16, KiB));
+
+	std::deque<std::string> outgoing;
+	size_t echoed = 0, closed = 0;
+	engine.AcceptMultishot(server, [&](Completion& accepted)
+	{
+		REQUIRE(accepted.Result != -1);
+		REQUIRE(accepted.More);
+		const Socket client = accepted.Client;
+		REQUIRE(client.FileNo() != INVALID_SOCKET);
+	#ifndef PLATFORM_WINDOWS
+		REQUIRE((fcntl(client.FileNo(), F_GETFD) & FD_CLOEXEC) != 0);//Both backends accept with the same flags
+	#endif
+
+		engine.ReceiveMultishot(client, [&, client](Completion& received)
+		{
+			if (received.Result <= 0)//End of stream
+			{
+				REQUIRE(!received.More);
+				closed++;
+				return;
+			}
+			REQUIRE(received.Data != nullptr);
+
+			//Received data belongs to the engine, so keep a copy around until it is sent
+			const std::string& msg = outgoing.emplace_back(reinterpret_cast<const char*>(received.Data), received.Result);
+			engine.Send(client, msg.data(), msg.size(), [&, size = msg.size()](Completion& sent)
+			{
+				REQUIRE(sent.Result == size);
+				echoed++;
+			});
+		});
+	});
+
+	auto task = std::async(std::launch::async, [port]()
+	{
+		std::vector<Socket> socks;
+		for (size_t i = 0; i < clients; i++)
+			socks.push_back(Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", port }));
+
+		for (size_t i = 0; i < clients; i++)
+		{
+			const std::string msg = "Hello from " + std::to_string(i);
+			char buffer[KiB] = { 0 };
+			REQUIRE(socks[i].Send(msg.c_str(), msg.size() + 1) == msg.size() + 1);
+			REQUIRE(socks[i].Receive(buffer, KiB) == msg.size() + 1);
+			REQUIRE(msg == buffer);
+		}
+
+		for (Socket& sock : socks)
+			sock.Close();
+	});
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (closed < clients && std::chrono::steady_clock::now() < deadline)
+		engine.Poll(10);
+	task.wait();
+
+	REQUIRE(echoed == clients);
+	REQUIRE(closed == clients);
+	REQUIRE(engine.Pending() == 1);//Only the multishot accept is left
+}
+
+TEST_CASE("Testing fallback engine", "[IOEngine]")
+{
+	IOEngine engine(256, false);
+	REQUIRE(!engine.UsesIOUring());
+	RunEchoServer(engine, 55635);
+}
+
+TEST_CASE("Testing default engine", "[IOEngine]")
+{
+	IOEngine engine;
+#ifdef PLATFORM_LINUX
+	if (!engine.UsesIOUring())
+		WARN("io_uring is not available, testing the fallback engine instead");
+#endif
+	RunEchoServer(engine, 55645);
+}
+
+TEST_CASE("Testing single shot operations", "[IOEngine]")
+{
+	IOEngine engine;
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55655 });
+
+	Socket client;
+	engine.Accept(server, [&](Completion& accepted)
+	{
+		REQUIRE(!accepted.More);
+		client = accepted.Client;
+	});
+	const Socket sock = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55655 });
+	while (engine.Pending() > 0)
+		engine.Poll(10);
+	REQUIRE(client.FileNo() != INVALID_SOCKET);
+
+	constexpr char msg[] = "Hello";
+	char buffer[16] = { 0 };
+	IOSize received = -1;
+	engine.Receive(client, buffer, 16, [&](Completion& completion) { received = completion.Result; });
+	engine.Send(sock, msg, sizeof(msg), [](Completion& completion) { REQUIRE(completion.Result == sizeof(msg)); });
+	while (engine.Pending() > 0)
+		engine.Poll(10);
+
+	REQUIRE(received == sizeof(msg));
+	REQUIRE(std::string(msg) == buffer);
+}
+
+TEST_CASE("Testing completion queue overflow", "[IOEngine]")
+{
+	static constexpr size_t sends = 64;
+	IOEngine engine(4);//Completion queue holds 8 entries, so most of them overflow
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56075 });
+	Socket sock = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 56075 });
+	sock.SetBlocking(false);//Lets the fallback engine perform all of them on a single notification
+	const auto [client, endpoint] = server.Accept();
+
+	constexpr char msg[] = "Hello";
+	size_t sent = 0;
+	for (size_t i = 0; i < sends; i++)
+		engine.Send(sock, msg, sizeof(msg), [&](Completion& completion) { if (completion.Result == sizeof(msg)) sent++; });
+
+	REQUIRE(engine.Poll(1000) == sends);//Overflowed completions are flushed and dispatched by the same call
+	REQUIRE(sent == sends);
+	REQUIRE(engine.Pending() == 0);
+}
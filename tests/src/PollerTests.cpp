@@ -0,0 +1,147 @@
+#include <catch.hpp>
+
+#include <future>
+
+#include <socklib/Poller.h>
+
+#include <thread>
+using namespace socklib;
+
+TEST_CASE("Testing Add() & Remove()", "[Poller]")
+{
+	Poller poller;
+	const Socket sock(AddressFamily::IPv4, SocketType::DGRAM);
+	poller.Add(sock, PollEvent::READABLE, [](SOCKET, PollEvent) {});
+	REQUIRE(poller.Contains(sock.FileNo()));
+	REQUIRE(poller.Size() == 1);
+
+	poller.Modify(sock, PollEvent::READABLE | PollEvent::WRITABLE);
+	REQUIRE(poller.Poll(0) == 1);//Datagram sockets are always writable
+
+	poller.Remove(sock);
+	REQUIRE(!poller.Contains(sock.FileNo()));
+	REQUIRE(poller.Size() == 0);
+}
+
+TEST_CASE("Testing Poll() timeout", "[Poller]")
+{
+	Poller poller;
+	Socket sock(AddressFamily::IPv4, SocketType::DGRAM);
+	sock.Bind("127.0.0.1", 55615);
+	sock.SetBlocking(false);
+
+	bool called = false;
+	poller.Add(sock, PollEvent::READABLE, [&](SOCKET, PollEvent) { called = true; });
+	REQUIRE(poller.Poll(10) == 0);
+	REQUIRE(!called);
+
+	char buffer[16];
+	REQUIRE(sock.Receive(buffer, 16) == -1);//Nothing to read on a non-blocking socket
+	poller.Remove(sock);
+}
+
+TEST_CASE("Testing Stop()", "[Poller]")
+{
+	Poller poller;
+	const auto task = std::async(std::launch::async, [&poller]() { poller.Run(); });
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));//Make sure the task starts before proceeding
+
+	poller.Stop();
+	REQUIRE(task.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+}
+
+TEST_CASE("Testing echo server", "[Poller]")
+{
+	static constexpr size_t clients = 8;
+	const auto task = std::async(std::launch::async, []()
+	{
+		Poller poller;
+		Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55625 });
+		server.SetBlocking(false);
+		std::vector<Socket> connections;
+		size_t served = 0;
+
+		poller.Add(server, PollEvent::READABLE, [&](SOCKET, PollEvent)
+		{
+			while (true)
+			{
+				auto [client, endpoint] = server.Accept();
+				if (client.FileNo() == INVALID_SOCKET) break;//EAGAIN: no more pending connections
+				client.SetBlocking(false);
+				poller.Add(client, PollEvent::READABLE, [&, client](const SOCKET sock, const PollEvent events)
+				{
+					char buffer[KiB];
+					IOSize bytes;
+					while ((bytes = client.Receive(buffer, KiB)) > 0)
+						client.Send(buffer, bytes);
+
+					if (bytes == 0 || HasEvent(events, PollEvent::HANGUP))
+					{
+						poller.Remove(sock);
+						if (++served == clients)
+							poller.Stop();
+					}
+				});
+				connections.push_back(client);
+			}
+		});
+
+		poller.Run();
+		poller.Remove(server);
+		REQUIRE(served == clients);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));//Make sure the task starts before proceeding
+
+	std::vector<Socket> socks;
+	for (size_t i = 0; i < clients; i++)
+		socks.push_back(Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55625 }));
+
+	for (size_t i = 0; i < clients; i++)
+	{
+		const std::string msg = "Hello from " + std::to_string(i);
+		char buffer[KiB] = { 0 };
+		REQUIRE(socks[i].Send(msg.c_str(), msg.size() + 1) == msg.size() + 1);
+		REQUIRE(socks[i].Receive(buffer, KiB) == msg.size() + 1);
+		REQUIRE(msg == buffer);
+	}
+
+	for (Socket& sock : socks)
+		sock.Close();
+
+	REQUIRE(task.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+}
+
+TEST_CASE("Testing descriptor reuse during dispatch", "[Poller]")
+{
+	Poller poller;
+	Socket socks[2] = { Socket(AddressFamily::IPv4, SocketType::DGRAM), Socket(AddressFamily::IPv4, SocketType::DGRAM) };
+	Socket replacement;
+	bool stale = false;
+
+	//Whichever callback runs first closes the other socket and opens a new one that reuses its descriptor
+	for (size_t i = 0; i < 2; i++)
+	{
+		poller.Add(socks[i], PollEvent::WRITABLE, [&, i](SOCKET, PollEvent)
+		{
+			if (replacement.FileNo() != INVALID_SOCKET) return;
+			Socket& other = socks[1 - i];
+			const SOCKET fd = other.FileNo();
+			poller.Remove(other);
+			other.Close();
+			replacement = Socket(AddressFamily::IPv4, SocketType::DGRAM);
+			REQUIRE(replacement.FileNo() == fd);
+			poller.Add(replacement, PollEvent::WRITABLE, [&](SOCKET, PollEvent) { stale = true; });
+		});
+	}
+
+	REQUIRE(poller.Poll(0) == 1);
+	REQUIRE(!stale);
+	REQUIRE(poller.Poll(0) == 2);//The new registration is reported from the next call on
+	REQUIRE(stale);
+
+	for (const Socket& sock : socks)
+		if (poller.Contains(sock.FileNo())) poller.Remove(sock);
+	poller.Remove(replacement);
+}
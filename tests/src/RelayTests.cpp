@@ -0,0 +1,85 @@
+#include <catch.hpp>
+
+#include <socklib/Relay.h>
+
+#include <future>
+#include <vector>
+using namespace socklib;
+
+TEST_CASE("Testing Relay", "[Relay]")
+{
+	static constexpr size_t upstream = 4 * MiB;
+	static constexpr size_t downstream = MiB;
+	std::vector<BYTE> request(upstream), response(downstream);
+	for (size_t i = 0; i < upstream; i++)
+		request[i] = static_cast<BYTE>(i * 7 + i / 251);
+	for (size_t i = 0; i < downstream; i++)
+		response[i] = static_cast<BYTE>(i * 13 + i / 509);
+
+	const Socket front = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55865 });
+	const Socket back = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55866 });
+
+	//The relay runs on its own Poller and thread, like it would in a proxy
+	Poller poller;
+	auto relay = std::async(std::launch::async, [&]()
+	{
+		const Socket client = front.Accept().first;
+		const Socket server = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55866 });
+		bool finished = false;
+		Relay relay(poller, client, server, [&](Relay&) { finished = true; poller.Stop(); });
+		REQUIRE(!relay.IsFinished());
+		poller.Run();
+
+		REQUIRE(finished);
+		REQUIRE(relay.IsFinished());
+		REQUIRE(!relay.Error());
+		REQUIRE(poller.Size() == 0);
+		return std::make_pair(relay.FirstToSecond(), relay.SecondToFirst());
+	});
+
+	auto server = std::async(std::launch::async, [&]()
+	{
+		const Socket sock = back.Accept().first;
+		std::vector<BYTE> buffer(upstream);
+		REQUIRE(sock.ReceiveExact(buffer.data(), upstream));
+		REQUIRE(buffer == request);
+
+		char byte;
+		REQUIRE(sock.Receive(&byte, 1) == 0);//The client's half-close made it through
+
+		//This direction is still open
+		REQUIRE(sock.SendAll(response.data(), downstream));
+		sock.Shutdown(SHUT_WR);
+	});
+
+	const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55865 });
+	REQUIRE(client.SendAll(request.data(), upstream));
+	client.Shutdown(SHUT_WR);
+
+	std::vector<BYTE> buffer(downstream);
+	REQUIRE(client.ReceiveExact(buffer.data(), downstream));
+	REQUIRE(buffer == response);
+	char byte;
+	REQUIRE(client.Receive(&byte, 1) == 0);
+
+	server.get();
+	const auto [toServer, toClient] = relay.get();
+	REQUIRE(toServer == upstream);
+	REQUIRE(toClient == downstream);
+}
+
+TEST_CASE("Testing Relay Close()", "[Relay]")
+{
+	const Socket listener = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55875 });
+	const Socket first = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55875 });
+	const Socket second = listener.Accept().first;
+
+	Poller poller;
+	bool called = false;
+	Relay relay(poller, first, second, [&called](Relay&) { called = true; });
+	REQUIRE(poller.Size() == 2);
+	relay.Close();
+	REQUIRE(relay.IsFinished());
+	REQUIRE(poller.Size() == 0);
+	REQUIRE(!called);
+}
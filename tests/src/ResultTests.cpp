@@ -0,0 +1,159 @@
+#include <catch.hpp>
+
+#include <future>
+#include <thread>
+
+#include <socklib/Socket.h>
+
+#ifndef PLATFORM_WINDOWS
+	#include <csignal>
+	#include <pthread.h>
+#endif
+using namespace socklib;
+
+TEST_CASE("Testing Result", "[Result]")
+{
+	{//Value
+		const Result<size_t> result = 42;
+		REQUIRE(result.has_value());
+		REQUIRE(result);
+		REQUIRE(*result == 42);
+		REQUIRE(result.value_or(0) == 42);
+	}
+
+	{//Error
+		const Result<size_t> result = Unexpected(std::make_error_code(std::errc::connection_reset));
+		REQUIRE(!result);
+		REQUIRE(result.error() == std::errc::connection_reset);
+		REQUIRE(result.value_or(0) == 0);
+	}
+
+	{//Move-only values
+		Result<UniqueSocket> result = UniqueSocket(AddressFamily::IPv4, SocketType::DGRAM);
+		REQUIRE(result);
+		const UniqueSocket sock = std::move(*result);
+		REQUIRE(sock.FileNo() != INVALID_SOCKET);
+	}
+
+	{//Nothing
+		const Result<void> ok;
+		REQUIRE(ok);
+		const Result<void> failed = Unexpected(std::make_error_code(std::errc::address_in_use));
+		REQUIRE(!failed);
+		REQUIRE(failed.error() == std::errc::address_in_use);
+	}
+}
+
+TEST_CASE("Testing Try* error reporting", "[Result]")
+{
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55745);
+
+	{//Nothing to receive on a non-blocking socket
+		Socket sock(AddressFamily::IPv4, SocketType::DGRAM);
+		REQUIRE(sock.TryBind(address));
+		sock.SetBlocking(false);
+
+		char buffer[16];
+		SocketAddress from;
+		const Result<size_t> received = sock.TryReceiveFrom(buffer, from, 16);
+		REQUIRE(!received);
+		REQUIRE(WouldBlock(received.error()));
+		REQUIRE(!from.IsValid());
+	}
+
+	{//Nobody to accept and the address is taken
+		Socket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		REQUIRE(server.TryBind(address));
+		REQUIRE(server.TryListen());
+		server.SetBlocking(false);
+
+		const Result<Socket> client = server.TryAccept();
+		REQUIRE(!client);
+		REQUIRE(WouldBlock(client.error()));
+
+		const UniqueSocket other(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		const Result<void> bound = other.TryBind(address);
+		REQUIRE(!bound);
+		REQUIRE(bound.error() == std::errc::address_in_use);
+		REQUIRE(!WouldBlock(bound.error()));
+	}
+
+	{//Nobody is listening
+		const UniqueSocket client(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		const Result<void> connected = client.TryConnect(address);
+		REQUIRE(!connected);
+		REQUIRE(connected.error() == std::errc::connection_refused);
+	}
+
+	{//Non-blocking connect is in progress
+		const UniqueSocket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		REQUIRE(server.TryBind(address));
+		REQUIRE(server.TryListen());
+
+		const UniqueSocket client(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		client.SetBlocking(false);
+		const Result<void> connected = client.TryConnect(address);
+		REQUIRE((connected || WouldBlock(connected.error())));
+	}
+}
+
+TEST_CASE("Testing Try* transfers", "[Result]")
+{
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55755);
+	const Socket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+	server.Bind(address);
+	server.Listen();
+
+	Socket client(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+	REQUIRE(client.TryConnect(address));
+	SocketAddress peer;
+	const Result<Socket> accepted = server.TryAccept(peer);
+	REQUIRE(accepted);
+	REQUIRE(peer.IsValid());
+
+	REQUIRE(client.TrySend("Hello", 6).value_or(0) == 6);
+	char buffer[16] = { 0 };
+	REQUIRE(accepted->TryReceive(buffer, 16).value_or(0) == 6);
+	REQUIRE(std::string("Hello") == buffer);
+
+	//End of stream is a successful receive of 0 bytes
+	client.Close();
+	const Result<size_t> received = accepted->TryReceive(buffer, 16);
+	REQUIRE(received);
+	REQUIRE(*received == 0);
+}
+
+#ifndef PLATFORM_WINDOWS
+TEST_CASE("Testing interrupted calls are restarted", "[Result]")
+{
+	//A handler without SA_RESTART, so the blocked recv() fails with EINTR
+	struct sigaction action = {};
+	struct sigaction previous = {};
+	action.sa_handler = [](int) {};
+	sigaction(SIGUSR1, &action, &previous);
+
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55765);
+	const Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+	receiver.Bind(address);
+
+	const pthread_t self = pthread_self();
+	auto task = std::async(std::launch::async, [self, &address]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		pthread_kill(self, SIGUSR1);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		const UniqueSocket sender(AddressFamily::IPv4, SocketType::DGRAM);
+		REQUIRE(sender.TrySendTo("Hello", address, 6).value_or(0) == 6);
+	});
+
+	char buffer[16] = { 0 };
+	SocketAddress from;
+	const Result<size_t> received = receiver.TryReceiveFrom(buffer, from, 16);
+	task.wait();
+	sigaction(SIGUSR1, &previous, nullptr);
+
+	REQUIRE(received);
+	REQUIRE(*received == 6);
+	REQUIRE(std::string("Hello") == buffer);
+}
+#endif
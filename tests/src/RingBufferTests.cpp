@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <socklib/RingBuffer.h>
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+using namespace socklib;
+
+TEST_CASE("Testing RingBuffer mapping", "[RingBuffer]")
+{
+	RingBuffer ring(1000);
+	REQUIRE(ring.IsValid());
+	REQUIRE(ring.Capacity() >= 1000);
+	REQUIRE(ring.Empty());
+	REQUIRE(ring.Free() == ring.Capacity());
+
+	//Both halves are the same memory
+	BYTE* data = ring.Writable().data();
+	data[0] = 0x42;
+	REQUIRE(data[ring.Capacity()] == 0x42);
+	data[ring.Capacity() + 1] = 0x24;
+	REQUIRE(data[1] == 0x24);
+
+	RingBuffer moved(std::move(ring));
+	REQUIRE(!ring.IsValid());
+	REQUIRE(moved.IsValid());
+	REQUIRE(moved.Writable().data()[0] == 0x42);
+}
+
+TEST_CASE("Testing RingBuffer wrap around", "[RingBuffer]")
+{
+	RingBuffer ring(1);//Rounded up to a page
+	const size_t capacity = ring.Capacity();
+	std::vector<BYTE> filler(capacity - 3, 0xAA);
+
+	REQUIRE(ring.Write(filler.data(), filler.size()) == filler.size());
+	REQUIRE(ring.Write("0123456789", 10) == 3);//Only 3 bytes of space left
+	REQUIRE(ring.Full());
+	ring.Consume(filler.size());
+	REQUIRE(ring.Size() == 3);
+
+	//The frame wraps around the end of the buffer but it is still contiguous
+	REQUIRE(ring.Write("3456789", 7) == 7);
+	const std::span<BYTE> frame = ring.Readable();
+	REQUIRE(frame.size() == 10);
+	REQUIRE(std::string_view(reinterpret_cast<const char*>(frame.data()), frame.size()) == "0123456789");
+
+	char buffer[4] = { 0 };
+	REQUIRE(ring.Read(buffer, 4) == 4);
+	REQUIRE(std::string_view(buffer, 4) == "0123");
+	REQUIRE(ring.Size() == 6);
+	REQUIRE(ring.Writable().size() == capacity - 6);
+
+	ring.Clear();
+	REQUIRE(ring.Empty());
+}
+
+TEST_CASE("Testing RingBuffer Receive()", "[RingBuffer]")
+{
+	Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+	receiver.Bind("127.0.0.1", 55885);
+	const Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+	sender.Connect("127.0.0.1", 55885);
+
+	RingBuffer ring(1);
+	std::vector<BYTE> filler(ring.Capacity() - 2, 0);
+	ring.Write(filler.data(), filler.size());
+	ring.Consume(filler.size() - 1);//One byte before the end of the buffer
+
+	REQUIRE(sender.Send("Hello", 5) == 5);
+	REQUIRE(ring.Receive(receiver).value_or(0) == 5);
+	REQUIRE(ring.Size() == 6);
+	REQUIRE(memcmp(ring.Readable().data() + 1, "Hello", 5) == 0);
+
+	receiver.SetBlocking(false);
+	const Result<size_t> nothing = ring.Receive(receiver);
+	REQUIRE(!nothing);
+	REQUIRE(WouldBlock(nothing.error()));
+}
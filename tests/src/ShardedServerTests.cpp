@@ -0,0 +1,138 @@
+#include <catch.hpp>
+
+#include <socklib/ShardedServer.h>
+
+#include <thread>
+#include <vector>
+#ifndef PLATFORM_WINDOWS
+	#include <fcntl.h>
+	#include <sys/resource.h>
+#endif
+#ifdef PLATFORM_LINUX
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+using namespace socklib;
+
+static void Greet(Poller&, const Socket client, const SocketAddress&)
+{
+	client.Send("hi", 2);//The connection is closed once the handler returns
+}
+
+static void Connect(const unsigned short port, const size_t clients)
+{
+	for (size_t i = 0; i < clients; i++)
+	{
+		const Socket sock = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", port });
+		char buffer[2];
+		REQUIRE(sock.Receive(buffer, 2) == 2);
+	}
+}
+
+TEST_CASE("Testing ShardedServer", "[ShardedServer]")
+{
+	static constexpr size_t clients = 64;
+	ShardedServerOptions options;
+	options.Shards = 4;
+	ShardedServer server(AddressFamily::IPv4, { "127.0.0.1", 55795 }, Greet, options);
+	REQUIRE(server.Shards() == 4);
+	REQUIRE(!server.IsSteered());
+	server.Start();
+
+	Connect(55795, clients);
+
+	uint64_t accepted = 0;
+	size_t busy = 0;
+	for (size_t i = 0; i < server.Shards(); i++)
+	{
+		accepted += server.Accepted(i);
+		busy += server.Accepted(i) > 0 ? 1 : 0;
+	}
+	REQUIRE(accepted == clients);
+#ifdef SO_REUSEPORT
+	REQUIRE(busy > 1);//The kernel spreads the connections between the listeners
+#endif
+	server.Stop();
+}
+
+TEST_CASE("Testing ShardedServer CPU steering", "[ShardedServer]")
+{
+	static constexpr size_t clients = 16;
+	ShardedServerOptions options;
+	options.Shards = 2;
+	options.SteerByCpu = true;
+	ShardedServer server(AddressFamily::IPv4, { "127.0.0.1", 55805 }, Greet, options);
+#ifdef PLATFORM_LINUX
+	REQUIRE(server.IsSteered());
+#endif
+	server.Start();
+
+	Connect(55805, clients);
+	REQUIRE(server.Accepted(0) + server.Accepted(1) == clients);
+
+#ifdef PLATFORM_LINUX
+	//Loopback traffic is received on the CPU that sends it, so the k-th allowed CPU lands on shard k % 2
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	REQUIRE(sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0);
+	size_t k = 0;
+	for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+	{
+		if (!CPU_ISSET(cpu, &allowed)) continue;
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		REQUIRE(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0);
+		const uint64_t before = server.Accepted(k % 2);
+		Connect(55805, 1);
+		REQUIRE(server.Accepted(k % 2) == before + 1);
+		k++;
+	}
+	REQUIRE(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &allowed) == 0);
+#endif
+	server.Stop();
+}
+
+#ifndef PLATFORM_WINDOWS
+TEST_CASE("Testing ShardedServer accept failures", "[ShardedServer]")
+{
+	static constexpr size_t clients = 4;
+	ShardedServerOptions options;
+	options.Shards = 1;
+	options.PinThreads = false;
+	ShardedServer server(AddressFamily::IPv4, { "127.0.0.1", 56095 }, Greet, options);
+
+	//The connections wait in the backlog until the server gets to accept them
+	std::vector<Socket> socks;
+	for (size_t i = 0; i < clients; i++)
+		socks.push_back(Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 56095 }));
+
+	//Lower the descriptor limit to the lowest free one, so accept fails with EMFILE
+	rlimit limit{};
+	REQUIRE(getrlimit(RLIMIT_NOFILE, &limit) == 0);
+	const int lowest = open("/dev/null", O_RDONLY);
+	REQUIRE(lowest != -1);
+	close(lowest);
+	rlimit exhausted = limit;
+	exhausted.rlim_cur = static_cast<rlim_t>(lowest);
+	REQUIRE(setrlimit(RLIMIT_NOFILE, &exhausted) == 0);
+
+	server.Start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	const uint64_t failures = server.AcceptFailures(0);
+	const uint64_t accepted = server.Accepted(0);
+	REQUIRE(setrlimit(RLIMIT_NOFILE, &limit) == 0);
+	REQUIRE(failures > 0);
+	REQUIRE(failures < 20);//Backed off instead of spinning on the readable listener
+	REQUIRE(accepted == 0);
+
+	//Once descriptors are available again the listener is re-armed
+	for (const Socket& sock : socks)
+	{
+		char buffer[2];
+		REQUIRE(sock.Receive(buffer, 2) == 2);
+	}
+	REQUIRE(server.Accepted(0) == clients);
+	server.Stop();
+}
+#endif
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+
+#include <future>
+
+#include <socklib/Socket.h>
+
+#include <unordered_set>
+using namespace socklib;
+
+TEST_CASE("Testing SocketAddress parsing", "[SocketAddress]")
+{
+	{//Default constructed
+		const SocketAddress address;
+		REQUIRE(!address.IsValid());
+		REQUIRE(address.Family() == AddressFamily::UNSPECIFIED);
+		REQUIRE(address.Size() == 0);
+		REQUIRE(address.Port() == 0);
+	}
+
+	{//IPv4
+		const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55555);
+		REQUIRE(address.IsValid());
+		REQUIRE(address.Family() == AddressFamily::IPv4);
+		REQUIRE(address.Size() == sizeof(sockaddr_in));
+		REQUIRE(address.Port() == 55555);
+		REQUIRE(address.Host() == "127.0.0.1");
+		REQUIRE(address.ToString() == "127.0.0.1:55555");
+		REQUIRE(reinterpret_cast<const sockaddr_in*>(address.Data())->sin_port == htons(55555));
+	}
+
+	{//IPv6
+		const SocketAddress address = SocketAddress::Parse(Endpoint("::1", 55555));
+		REQUIRE(address.IsValid());
+		REQUIRE(address.Family() == AddressFamily::IPv6);
+		REQUIRE(address.Size() == sizeof(sockaddr_in6));
+		REQUIRE(address.ToString() == "[::1]:55555");
+
+		const Endpoint endpoint = address.ToEndpoint();
+		REQUIRE(endpoint.Host == "::1");
+		REQUIRE(endpoint.Port == 55555);
+	}
+
+	{//Not an IP address
+		REQUIRE(!SocketAddress::Parse("localhost", 80).IsValid());
+		REQUIRE(!SocketAddress::Parse(nullptr, 80).IsValid());
+	}
+
+	{//Wildcard addresses
+		REQUIRE(SocketAddress::Any(AddressFamily::IPv4, 80) == SocketAddress::Parse("0.0.0.0", 80));
+		REQUIRE(SocketAddress::Any(AddressFamily::IPv6, 80) == SocketAddress::Parse("::", 80));
+	}
+}
+
+TEST_CASE("Testing SocketAddress comparison and hashing", "[SocketAddress]")
+{
+	const SocketAddress a = SocketAddress::Parse("10.0.0.1", 1000);
+	const SocketAddress b = SocketAddress::Parse("10.0.0.1", 1000);
+	const SocketAddress otherPort = SocketAddress::Parse("10.0.0.1", 1001);
+	const SocketAddress otherHost = SocketAddress::Parse("10.0.0.2", 1000);
+	const SocketAddress v6 = SocketAddress::Parse("::ffff:10.0.0.1", 1000);
+
+	REQUIRE(a == b);
+	REQUIRE(a.Hash() == b.Hash());
+	REQUIRE(a != otherPort);
+	REQUIRE(a != otherHost);
+	REQUIRE(a != v6);
+
+	const SocketAddress copy(a.Data(), a.Size());
+	REQUIRE(copy == a);
+
+	std::unordered_set<SocketAddress> peers{ a, b, otherPort, otherHost, v6 };
+	REQUIRE(peers.size() == 4);
+	REQUIRE(peers.contains(SocketAddress::Parse("10.0.0.2", 1000)));
+}
+
+TEST_CASE("Testing SocketAddress based I/O", "[SocketAddress]")
+{
+	{//Datagrams
+		const SocketAddress recverAddress = SocketAddress::Parse("127.0.0.1", 55725);
+		const SocketAddress senderAddress = SocketAddress::Parse("127.0.0.1", 55726);
+		const Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+		receiver.Bind(recverAddress);
+		const Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+		sender.Bind(senderAddress);
+
+		REQUIRE(sender.SendTo("Hello", recverAddress, 6) == 6);
+
+		char buffer[16] = { 0 };
+		SocketAddress from;
+		REQUIRE(receiver.ReceiveFrom(buffer, from, 16) == 6);
+		REQUIRE(std::string("Hello") == buffer);
+		REQUIRE(from == senderAddress);
+	}
+
+	{//Streams
+		const SocketAddress serverAddress = SocketAddress::Parse("127.0.0.1", 55735);
+		const Socket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		server.Bind(serverAddress);
+		server.Listen();
+
+		auto task = std::async(std::launch::async, [&serverAddress]()
+		{
+			const Socket client(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+			client.Bind(SocketAddress::Parse("127.0.0.1", 55736));
+			client.Connect(serverAddress);
+			REQUIRE(client.Send("Hello", 6) == 6);
+		});
+
+		SocketAddress peer;
+		const Socket client = server.Accept(peer);
+		REQUIRE(client.FileNo() != INVALID_SOCKET);
+		REQUIRE(peer == SocketAddress::Parse("127.0.0.1", 55736));
+
+		char buffer[16] = { 0 };
+		REQUIRE(client.Receive(buffer, 16) == 6);
+		task.wait();
+	}
+}
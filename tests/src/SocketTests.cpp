@@ -1,12 +1,25 @@
 #include <catch.hpp>
 
+#include <cstring>
 #include <future>
 
 #include <socklib/Socket.h>
 
 #include <thread>
+#include <vector>
+#ifndef PLATFORM_WINDOWS
+	#include <netinet/tcp.h>
+#endif
 using namespace socklib;
 
+static int GetOption(const Socket& sock, const int level, const int name)
+{
+	int value = 0;
+	socklen_t size = sizeof(value);
+	getsockopt(sock.FileNo(), level, name, reinterpret_cast<char*>(&value), &size);
+	return value;
+}
+
 TEST_CASE("Testing Default Constructor", "[Socket]")
 {
 	const Socket sock;
@@ -72,6 +85,86 @@ TEST_CASE("Testing Open()", "[Socket]")
 	}
 }
 
+TEST_CASE("Testing Open() with options", "[Socket]")
+{
+	{//The defaults open the same socket as before
+		const Socket sock(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP, {});
+		REQUIRE(sock.IsBlocking());
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_REUSEADDR) != 0);
+		REQUIRE(GetOption(sock, IPPROTO_TCP, TCP_NODELAY) == 0);
+	}
+
+	SocketOptions options;
+	options.NonBlocking = true;
+	options.CloseOnExec = true;
+	options.ReuseAddress = false;
+	options.NoDelay = true;
+	options.KeepAlive = true;
+	options.SendBuffer = 64 * KiB;
+	options.ReceiveBuffer = 64 * KiB;
+	options.Linger = 0;
+	{
+		Socket sock(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP, options);
+		REQUIRE(!sock.IsBlocking());
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_REUSEADDR) == 0);
+		REQUIRE(GetOption(sock, IPPROTO_TCP, TCP_NODELAY) != 0);
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_KEEPALIVE) != 0);
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_SNDBUF) >= options.SendBuffer);
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_RCVBUF) >= options.ReceiveBuffer);
+		linger value{};
+		socklen_t size = sizeof(value);
+		getsockopt(sock.FileNo(), SOL_SOCKET, SO_LINGER, reinterpret_cast<char*>(&value), &size);
+		REQUIRE(value.l_onoff != 0);
+		REQUIRE(value.l_linger == 0);
+	#ifndef PLATFORM_WINDOWS
+		REQUIRE((fcntl(sock.FileNo(), F_GETFL) & O_NONBLOCK) != 0);
+		REQUIRE((fcntl(sock.FileNo(), F_GETFD) & FD_CLOEXEC) != 0);
+
+		//SetBlocking flips the flag without touching the others
+		sock.SetBlocking(true);
+		REQUIRE((fcntl(sock.FileNo(), F_GETFL) & O_NONBLOCK) == 0);
+		REQUIRE((fcntl(sock.FileNo(), F_GETFD) & FD_CLOEXEC) != 0);
+		sock.SetBlocking(false);
+		REQUIRE((fcntl(sock.FileNo(), F_GETFL) & O_NONBLOCK) != 0);
+	#endif
+	}
+
+#ifdef PLATFORM_LINUX
+	{//Priority is Linux only
+		SocketOptions priority;
+		priority.Priority = 4;
+		const Socket sock(AddressFamily::IPv6, SocketType::DGRAM, 0, priority);
+		REQUIRE(GetOption(sock, SOL_SOCKET, SO_PRIORITY) == 4);
+	}
+#endif
+
+	{//Reopening follows the options of the new socket
+		Socket sock(AddressFamily::IPv4, SocketType::DGRAM, 0, options);
+		sock.Close();
+		sock.Open(AddressFamily::IPv4, SocketType::DGRAM);
+		REQUIRE(sock.IsBlocking());
+	}
+
+	{//Servers and connections take them too
+		SocketOptions server;
+		server.NonBlocking = true;
+		Socket listener = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 56055 }, server);
+		REQUIRE(!listener.IsBlocking());
+		const Result<Socket> none = listener.TryAccept();
+		REQUIRE(!none);
+		REQUIRE(WouldBlock(none.error()));
+
+		SocketOptions client;
+		client.NoDelay = true;
+		const Socket connection = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 56055 }, client, 1000);
+		REQUIRE(connection.FileNo() != INVALID_SOCKET);
+		REQUIRE(connection.IsBlocking());
+		REQUIRE(GetOption(connection, IPPROTO_TCP, TCP_NODELAY) != 0);
+		listener.SetBlocking(true);
+		REQUIRE(listener.TryAccept().has_value());
+	}
+}
+
 TEST_CASE("Testing Close()", "[Socket]")
 {
 	Socket sock;
@@ -354,6 +447,161 @@ TEST_CASE("Testing Connect()", "[Socket]")
 }
 
 
+TEST_CASE("Testing connect deadlines", "[Socket]")
+{
+	//A listener whose accept queue is full drops further handshakes, so connecting to it stalls
+	const Socket stalled = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55975 }, 0);
+	const SocketAddress stalledAddress = SocketAddress::Parse("127.0.0.1", 55975);
+	std::vector<Socket> queued;
+	for (int i = 0; i < 8; i++)
+	{
+		Socket filler(AddressFamily::IPv4, SocketType::STREAM);
+		if (!filler.TryConnect(stalledAddress, 100)) break;
+		queued.push_back(std::move(filler));
+	}
+	REQUIRE(queued.size() < 8);
+
+	{//The deadline bounds the connect, and fails it
+		const Socket client(AddressFamily::IPv4, SocketType::STREAM);
+		const auto start = std::chrono::steady_clock::now();
+		const Result<void> result = client.TryConnect(stalledAddress, 100);
+		REQUIRE(!result);
+		REQUIRE(result.error() == std::errc::timed_out);
+		REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+		REQUIRE(client.IsBlocking());
+	}
+
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55955 });
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55955);
+
+	{//A connect within the deadline leaves no timeouts behind
+		Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55955 }, 1000);
+		REQUIRE(client.FileNo() != INVALID_SOCKET);
+		REQUIRE(client.IsBlocking());
+	#ifndef PLATFORM_WINDOWS
+		timeval timeout = {};
+		socklen_t size = sizeof(timeout);
+		getsockopt(client.FileNo(), SOL_SOCKET, SO_SNDTIMEO, &timeout, &size);
+		REQUIRE((timeout.tv_sec == 0 && timeout.tv_usec == 0));
+	#endif
+		Socket peer = server.Accept().first;
+		REQUIRE(peer.FileNo() != INVALID_SOCKET);
+
+		//Non-blocking sockets stay non-blocking
+		Socket other(AddressFamily::IPv4, SocketType::STREAM);
+		other.SetBlocking(false);
+		REQUIRE(other.TryConnect(address, 1000));
+		REQUIRE(!other.IsBlocking());
+		char byte;
+		REQUIRE(!other.TryReceive(&byte, 1));
+		peer = server.Accept().first;
+	}
+
+	{//The first candidate to answer wins, refused and stalled ones don't hold it up
+		const Socket refused(AddressFamily::IPv4, SocketType::STREAM);
+		refused.Bind("127.0.0.1", 55965);//Bound but not listening
+		const SocketAddress refusedAddress = SocketAddress::Parse("127.0.0.1", 55965);
+
+		const SocketAddress candidates[] = { stalledAddress, refusedAddress, address };
+		size_t winner = 0;
+		const auto start = std::chrono::steady_clock::now();
+		const Result<Socket> client = Socket::TryConnectFirst(candidates, 5000, &winner);
+		REQUIRE(client.has_value());
+		REQUIRE(winner == 2);
+		REQUIRE(client->IsBlocking());
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+		const char message[] = "hello";
+		REQUIRE(client->SendAll(message, sizeof(message)));
+		char received[sizeof(message)];
+		REQUIRE(server.Accept().first.ReceiveExact(received, sizeof(received), 1000));
+		REQUIRE(strcmp(received, message) == 0);
+
+		//Without any candidate that answers the last failure is reported
+		const Result<Socket> none = Socket::TryConnectFirst(std::span<const SocketAddress>(candidates, 2), 100);
+		REQUIRE(!none);
+		REQUIRE(none.error() == std::errc::timed_out);
+		const Result<Socket> failed = Socket::TryConnectFirst(std::span<const SocketAddress>(candidates + 1, 1), 100);
+		REQUIRE(!failed);
+		REQUIRE(failed.error() == std::errc::connection_refused);
+		REQUIRE(Socket::TryConnectFirst({}).error() == std::errc::invalid_argument);
+
+		//A candidate that fails right away doesn't cost the next one its stagger, even with another in flight
+		const SocketAddress unreachable[] = { stalledAddress, SocketAddress::Parse("224.0.0.1", 55965), address };//TCP can't connect to multicast
+		const auto staggered = std::chrono::steady_clock::now();
+		const Result<std::pair<UniqueSocket, size_t>> second = UniqueSocket::TryConnectFirst(unreachable, 5000, 300);
+		REQUIRE(second.has_value());
+		REQUIRE(second->second == 2);
+		const auto elapsed = std::chrono::steady_clock::now() - staggered;
+		REQUIRE(elapsed >= std::chrono::milliseconds(300));
+		REQUIRE(elapsed < std::chrono::milliseconds(600));
+	}
+}
+
+
+TEST_CASE("Testing Happy Eyeballs", "[Socket]")
+{
+	Socket server4 = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55985 });
+	const Socket server6 = Socket::CreateServer(AddressFamily::IPv6, { "::1", 55985 });
+	const SocketAddress address4 = SocketAddress::Parse("127.0.0.1", 55985);
+	const SocketAddress address6 = SocketAddress::Parse("::1", 55985);
+	server4.SetBlocking(false);
+
+	{//IPv6 goes first, when it answers IPv4 is never tried
+		const SocketAddress addresses[] = { address4, address6 };
+		size_t winner = 0;
+		const Result<Socket> client = Socket::TryConnectDualStack(addresses, 5000, 200, &winner);
+		REQUIRE(client.has_value());
+		REQUIRE(winner == 1);
+		REQUIRE(server6.Accept().first.FileNo() != INVALID_SOCKET);
+		REQUIRE(!server4.TryAccept());
+	}
+
+	//An IPv6 listener whose accept queue is full stands in for a blackholed family
+	const Socket stalled = Socket::CreateServer(AddressFamily::IPv6, { "::1", 55995 }, 0);
+	const SocketAddress stalledAddress = SocketAddress::Parse("::1", 55995);
+	std::vector<Socket> queued;
+	for (int i = 0; i < 8; i++)
+	{
+		Socket filler(AddressFamily::IPv6, SocketType::STREAM);
+		if (!filler.TryConnect(stalledAddress, 100)) break;
+		queued.push_back(std::move(filler));
+	}
+	REQUIRE(queued.size() < 8);
+
+	{//IPv4 starts once IPv6 has been going for the stagger delay
+		const SocketAddress addresses[] = { address4, stalledAddress };
+		size_t winner = 1;
+		const auto start = std::chrono::steady_clock::now();
+		const Result<Socket> client = Socket::TryConnectDualStack(addresses, 5000, 100, &winner);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		REQUIRE(client.has_value());
+		REQUIRE(client->IsBlocking());
+		REQUIRE(winner == 0);
+		REQUIRE(elapsed >= std::chrono::milliseconds(100));
+		REQUIRE(elapsed < std::chrono::seconds(1));
+	}
+
+	{//A family that fails right away doesn't wait for the stagger
+		const Socket refused(AddressFamily::IPv6, SocketType::STREAM);
+		refused.Bind("::1", 56005);//Bound but not listening
+		const SocketAddress addresses[] = { SocketAddress::Parse("::1", 56005), address4 };
+		size_t winner = 0;
+		const auto start = std::chrono::steady_clock::now();
+		const Result<Socket> client = Socket::TryConnectDualStack(addresses, 5000, 1000, &winner);
+		REQUIRE(client.has_value());
+		REQUIRE(winner == 1);
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+	}
+
+	{//Only blackholed addresses, the deadline ends the attempts
+		const SocketAddress addresses[] = { stalledAddress, stalledAddress };
+		const Result<Socket> client = Socket::TryConnectDualStack(addresses, 150, 50);
+		REQUIRE(!client);
+		REQUIRE(client.error() == std::errc::timed_out);
+	}
+}
+
+
 TEST_CASE("Testing Datagram Transmission", "[Socket]")
 {
 
@@ -509,6 +757,234 @@ TEST_CASE("Testing Datagram Transmission", "[Socket]")
 	}
 }
 
+TEST_CASE("Testing vectored I/O", "[Socket]")
+{
+	{//Stream
+		const auto task = std::async(std::launch::async, []()
+		{
+			const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55675 });
+			auto [client, endpoint] = server.Accept();
+
+			uint32_t header = 0;
+			char body[16] = { 0 };
+			const IOBuffer buffers[] = { { &header, sizeof(uint32_t) }, { body, 16 } };
+			REQUIRE(client.ReceiveV(buffers) == sizeof(uint32_t) + 6);
+			REQUIRE(ntohl(header) == 6);
+			REQUIRE(std::string("Hello") == body);
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));//Make sure the task starts before proceeding
+
+		const Socket sock = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55675 });
+		constexpr char body[] = "Hello";
+		const uint32_t header = htonl(sizeof(body));
+		const IOBuffer buffers[] = { { &header, sizeof(uint32_t) }, { body, sizeof(body) } };
+		REQUIRE(sock.SendV(buffers) == sizeof(uint32_t) + sizeof(body));
+
+		task.wait();
+	}
+
+	{//Datagram
+		const Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+		receiver.Bind("127.0.0.1", 55685);
+		const Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+		sender.Bind("127.0.0.1", 55686);
+
+		sockaddr_in address = { 0 };
+		address.sin_family = AF_INET;
+		address.sin_port = htons(55685);
+		inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+		constexpr char first[] = "Hello";
+		constexpr char second[] = "World";
+		const IOBuffer outgoing[] = { { first, sizeof(first) }, { second, sizeof(second) } };
+		REQUIRE(sender.SendToV(outgoing, reinterpret_cast<sockaddr*>(&address), sizeof(sockaddr_in)) == sizeof(first) + sizeof(second));
+
+		char buffer[12] = { 0 };
+		const IOBuffer incoming[] = { { buffer, 6 }, { &buffer[6], 6 } };
+		sockaddr_in senderAddress = { 0 };
+		socklen_t addressSize = sizeof(sockaddr_in);
+		REQUIRE(receiver.ReceiveFromV(incoming, reinterpret_cast<sockaddr*>(&senderAddress), &addressSize) == 12);
+		REQUIRE(std::string("Hello") == buffer);
+		REQUIRE(std::string("World") == &buffer[6]);
+		REQUIRE(addressSize == sizeof(sockaddr_in));
+		REQUIRE(senderAddress.sin_port == htons(55686));
+	}
+}
+
+TEST_CASE("Testing batched Datagram Transmission", "[Socket]")
+{
+	Socket receiver(AddressFamily::IPv4, SocketType::DGRAM);
+	receiver.Bind("127.0.0.1", 55665);
+	Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+	sender.Bind("127.0.0.1", 55666);
+
+	const SocketAddress recverAddress = SocketAddress::Parse("127.0.0.1", 55665);
+	const SocketAddress senderAddress = SocketAddress::Parse("127.0.0.1", 55666);
+
+	char messages[3][6] = { "Hello", "from", "batch" };
+	Datagram outgoing[3];
+	for (size_t i = 0; i < 3; i++)
+	{
+		outgoing[i].Data = messages[i];
+		outgoing[i].Length = strlen(messages[i]) + 1;
+		outgoing[i].Address = recverAddress;
+	}
+	REQUIRE(sender.SendBatch(outgoing) == 3);
+	for (const Datagram& datagram : outgoing)
+		REQUIRE(datagram.Bytes == datagram.Length);
+
+	char buffers[4][16] = { { 0 } };
+	Datagram incoming[4];
+	for (size_t i = 0; i < 4; i++)
+	{
+		incoming[i].Data = buffers[i];
+		incoming[i].Length = 16;
+	}
+
+	size_t received = 0;
+	while (received < 3)//Other platforms receive a single datagram at a time
+	{
+		const IOSize count = receiver.ReceiveBatch(std::span(incoming).subspan(received));
+		REQUIRE(count > 0);
+		received += count;
+	}
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		REQUIRE(incoming[i].Bytes == outgoing[i].Length);
+		REQUIRE(std::string(messages[i]) == buffers[i]);
+		REQUIRE(incoming[i].Address.Size() == sizeof(sockaddr_in));
+		REQUIRE(incoming[i].Address == senderAddress);
+	}
+
+	receiver.SetTimeout(10);
+	REQUIRE(receiver.ReceiveBatch(incoming) == -1);
+}
+
+TEST_CASE("Testing file transmission", "[Socket]")
+{
+	static constexpr size_t size = 3 * MiB + 123;
+	std::vector<BYTE> content(size);
+	for (size_t i = 0; i < size; i++)
+		content[i] = static_cast<BYTE>(i * 31 + i / 7);
+
+	FILE* source = tmpfile();
+	FILE* target = tmpfile();
+	REQUIRE(source != nullptr);
+	REQUIRE(target != nullptr);
+	REQUIRE(fwrite(content.data(), 1, size, source) == size);
+	fflush(source);
+
+	auto matches = [&content, target]()
+	{
+		std::vector<BYTE> written(size);
+		fseek(target, 0, SEEK_SET);
+		return fread(written.data(), 1, size, target) == size && written == content;
+	};
+
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55855 });
+	Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55855 });
+	Socket peer = server.Accept().first;
+
+	//Blocking sockets transfer everything in one call
+	auto task = std::async(std::launch::async, [&peer, target]() { return peer.ReceiveToFile(fileno(target), 0, size); });
+	REQUIRE(client.SendFile(fileno(source), 0, size) == size);
+	REQUIRE(task.get() == size);
+	REQUIRE(matches());
+
+	//Ranges past the end of the file stop at the end of it
+	REQUIRE(client.SendFile(fileno(source), size - 10, 100) == 10);
+	REQUIRE(peer.ReceiveToFile(fileno(target), size, 10) == 10);
+
+	//Non-blocking sockets transfer what they can and the caller continues from there
+	client.SetBlocking(false);
+	peer.SetBlocking(false);
+	REQUIRE(peer.ReceiveToFile(fileno(target), 0, size) == -1);
+
+	size_t sent = 0, received = 0;
+	while (received < size)
+	{
+		if (sent < size)
+		{
+			const IOSize bytes = client.SendFile(fileno(source), sent, size - sent);
+			if (bytes > 0) sent += bytes;
+		}
+		const IOSize bytes = peer.ReceiveToFile(fileno(target), received, size - received);
+		REQUIRE(bytes != 0);
+		if (bytes > 0) received += bytes;
+	}
+	REQUIRE(sent == size);
+	REQUIRE(matches());
+
+	fclose(source);
+	fclose(target);
+}
+
+TEST_CASE("Testing SendAll() & ReceiveExact()", "[Socket]")
+{
+	static constexpr size_t size = 2 * MiB;
+	std::vector<BYTE> payload(size);
+	for (size_t i = 0; i < size; i++)
+		payload[i] = static_cast<BYTE>(i * 31 + i / 4093);
+
+	//Tiny kernel buffers force every transfer to be split into many partial ones
+	constexpr int bufferSize = 4 * KiB;
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55935 });
+	setsockopt(server.FileNo(), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(int));
+	Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55935 });
+	setsockopt(client.FileNo(), SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(int));
+	Socket peer = server.Accept().first;
+
+	struct Header {
+		uint32_t Magic;
+		uint32_t Length;
+	};
+
+	//A header in front of the payload is sent along with it, without copying either
+	auto task = std::async(std::launch::async, [&peer, &payload]()
+	{
+		Header header = {};
+		std::vector<BYTE> body(size);
+		IOBuffer buffers[2] = { { &header, sizeof(Header) }, { body.data(), body.size() } };
+		return peer.ReceiveExactV(buffers).has_value() && header.Magic == 0xC0FFEE && header.Length == size && body == payload;
+	});
+	Header header = { 0xC0FFEE, static_cast<uint32_t>(size) };
+	IOBuffer buffers[2] = { { &header, sizeof(Header) }, { payload.data(), payload.size() } };
+	REQUIRE(client.SendAllV(buffers));
+	REQUIRE(buffers[0].Length == 0);
+	REQUIRE(buffers[1].Length == 0);
+	REQUIRE(task.get());
+
+	//The timeout bounds the whole transfer
+	char byte;
+	const auto start = std::chrono::steady_clock::now();
+	const Result<void> timedOut = peer.ReceiveExact(&byte, 1, 50);
+	REQUIRE(!timedOut);
+	REQUIRE(WouldBlock(timedOut.error()));
+	REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+
+	//With a timeout non-blocking sockets wait for each other as well
+	client.SetBlocking(false);
+	peer.SetBlocking(false);
+	std::vector<BYTE> body(size);
+	auto reader = std::async(std::launch::async, [&peer, &body]() { return peer.ReceiveExact(body.data(), size, 10000).has_value(); });
+	REQUIRE(client.SendAll(payload.data(), size, 10000));
+	REQUIRE(reader.get());
+	REQUIRE(body == payload);
+
+	//Nobody is reading, so the sender runs out of time
+	const Result<void> stuck = client.SendAll(payload.data(), size, 50);
+	REQUIRE(!stuck);
+	REQUIRE(WouldBlock(stuck.error()));
+
+	//The peer shuts down before enough bytes arrived
+	client.Shutdown(SHUT_WR);
+	const Result<void> truncated = peer.ReceiveExact(body.data(), size, 10000);
+	REQUIRE(!truncated);
+	REQUIRE(truncated.error() == std::errc::no_message);
+}
+
 TEST_CASE("Testing static functions", "[Socket]")
 {
 	const auto task = std::async(std::launch::async, [](){
@@ -621,10 +1097,13 @@ TEST_CASE("Send timeout", "[Socket]")
 	sock.Connect(endpoint);
 
 	constexpr char buffer[KiB] = { 0 };
-	const IOSize bytes = sock.Send(buffer, KiB);
 #ifdef PLATFORM_WINDOWS
+	const IOSize bytes = sock.Send(buffer, KiB);
 	REQUIRE(bytes == KiB);
 #else
+	IOSize bytes = 0;
+	for (size_t sent = 0; bytes != -1 && sent < 64 * MiB; sent += bytes)//Keep sending until the kernel buffers are full
+		bytes = sock.Send(buffer, KiB);
 	REQUIRE(bytes == -1);
 #endif
 	task.wait();
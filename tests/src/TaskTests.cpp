@@ -0,0 +1,182 @@
+#include <catch.hpp>
+
+#include <socklib/Task.h>
+
+#include <cstring>
+using namespace socklib;
+
+static Task<int> Answer()
+{
+	co_return 42;
+}
+
+static Task<int> Increment()
+{
+	const int value = co_await Answer();
+	co_return value + 1;
+}
+
+static Task<size_t> Depth(const size_t depth)
+{
+	if (depth == 0) co_return 0;
+	co_return co_await Depth(depth - 1) + 1;
+}
+
+static Task<> Flag(bool& flag)
+{
+	flag = true;
+	co_return;
+}
+
+TEST_CASE("Testing Task", "[Task]")
+{
+	Task<int> task = Increment();
+	REQUIRE(!task.Done());//Tasks are lazy
+	task.Start();
+	REQUIRE(task.Done());
+	REQUIRE(task.Value() == 43);
+
+	Task<size_t> deep = Depth(10000);//Symmetric transfer keeps the stack flat
+	deep.Start();
+	REQUIRE(deep.Value() == 10000);
+
+	bool flag = false;
+	Flag(flag).Detach();//Detached Tasks run right away and destroy themselves
+	REQUIRE(flag);
+}
+
+static Task<> Echo(Poller& poller, const Socket client, size_t& closed)
+{
+	char buffer[KiB];
+	while (true)
+	{
+		const Result<size_t> bytes = co_await client.AsyncReceive(poller, buffer, KiB);
+		if (!bytes || *bytes == 0) break;
+		if (!co_await client.AsyncSend(poller, buffer, *bytes)) break;
+	}
+	closed++;
+}
+
+static Task<> Serve(Poller& poller, const Socket server, const size_t clients, size_t& closed)
+{
+	for (size_t i = 0; i < clients; i++)
+	{
+		SocketAddress address;
+		Result<Socket> client = co_await server.AsyncAccept(poller, address);
+		REQUIRE(client);
+		REQUIRE(!client->IsBlocking());
+		REQUIRE(address.Family() == AddressFamily::IPv4);
+		Echo(poller, std::move(*client), closed).Detach();
+	}
+}
+
+static Task<> Client(Poller& poller, const SocketAddress address, size_t& completed)
+{
+	Socket sock(AddressFamily::IPv4, SocketType::STREAM);
+	sock.SetBlocking(false);
+	REQUIRE(co_await sock.AsyncConnect(poller, address));
+
+	static constexpr char message[] = "Hello coroutines!";
+	REQUIRE((co_await sock.AsyncSend(poller, message, sizeof(message))).value_or(0) == sizeof(message));
+
+	char buffer[sizeof(message)];
+	size_t received = 0;
+	while (received < sizeof(message))
+	{
+		const Result<size_t> bytes = co_await sock.AsyncReceive(poller, buffer + received, sizeof(message) - received);
+		REQUIRE(bytes);
+		REQUIRE(*bytes > 0);
+		received += *bytes;
+	}
+	REQUIRE(memcmp(buffer, message, sizeof(message)) == 0);
+	completed++;
+}
+
+TEST_CASE("Testing coroutine echo server", "[Task]")
+{
+	static constexpr size_t clients = 128;
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 55775);
+
+	Poller poller;
+	Socket server(AddressFamily::IPv4, SocketType::STREAM);
+	server.Bind(address);
+	server.Listen();
+	server.SetBlocking(false);
+
+	size_t completed = 0, closed = 0;
+	Serve(poller, server, clients, closed).Detach();
+	for (size_t i = 0; i < clients; i++)
+		Client(poller, address, completed).Detach();
+
+	//A single thread drives the server and all the clients
+	for (size_t i = 0; i < 10000 && (completed < clients || closed < clients); i++)
+		poller.Poll(100);
+
+	REQUIRE(completed == clients);
+	REQUIRE(closed == clients);
+	REQUIRE(poller.Size() == 0);
+}
+
+static Task<Result<void>> ConnectTo(Poller& poller, const Socket sock, const SocketAddress address)
+{
+	co_return co_await sock.AsyncConnect(poller, address);
+}
+
+TEST_CASE("Testing AsyncConnect() failure", "[Task]")
+{
+	Poller poller;
+	Socket sock(AddressFamily::IPv4, SocketType::STREAM);
+	sock.SetBlocking(false);
+
+	Task<Result<void>> task = ConnectTo(poller, sock, SocketAddress::Parse("127.0.0.1", 55785));//Nobody listens here
+	task.Start();
+	for (size_t i = 0; i < 100 && !task.Done(); i++)
+		poller.Poll(100);
+
+	REQUIRE(task.Done());
+	REQUIRE(!task.Value());
+	REQUIRE(task.Value().error() == std::errc::connection_refused);
+}
+
+static Task<> ReceiveOne(Poller& poller, const Socket sock, bool& received)
+{
+	char buffer[16];
+	co_await sock.AsyncReceive(poller, buffer, sizeof(buffer));
+	received = true;
+}
+
+TEST_CASE("Testing destroying a suspended Task", "[Task]")
+{
+	const SocketAddress address = SocketAddress::Parse("127.0.0.1", 56085);
+	Poller poller;
+	Socket sock(AddressFamily::IPv4, SocketType::DGRAM);
+	sock.Bind(address);
+	sock.SetBlocking(false);
+
+	bool received = false;
+	{
+		Task<> task = ReceiveOne(poller, sock, received);
+		task.Start();
+		REQUIRE(!task.Done());
+		REQUIRE(poller.Contains(sock.FileNo()));
+	}//Destroyed while waiting for data
+	REQUIRE(poller.Size() == 0);
+
+	const Socket sender(AddressFamily::IPv4, SocketType::DGRAM);
+	constexpr char msg[] = "Hello";
+	REQUIRE(sender.SendTo(msg, address, sizeof(msg)) == sizeof(msg));
+	REQUIRE(poller.Poll(100) == 0);//Nobody is left to call back
+	REQUIRE(!received);
+
+	//The socket may also be closed before the Task that waits on it goes away
+	char buffer[16];
+	REQUIRE(sock.TryReceive(buffer, sizeof(buffer)).value() == sizeof(msg));
+	{
+		Task<> task = ReceiveOne(poller, sock, received);
+		task.Start();
+		REQUIRE(poller.Contains(sock.FileNo()));
+		sock.Close();
+	}
+	REQUIRE(poller.Size() == 0);
+	REQUIRE(!received);
+}
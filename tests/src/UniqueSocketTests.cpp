@@ -0,0 +1,174 @@
+#include <catch.hpp>
+
+#include <future>
+
+#include <socklib/Socket.h>
+
+#include <type_traits>
+#include <vector>
+using namespace socklib;
+
+static sockaddr_in LoopbackAddress(const unsigned short port)
+{
+	sockaddr_in address = { 0 };
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+	return address;
+}
+
+TEST_CASE("Testing UniqueSocket layout", "[UniqueSocket]")
+{
+	STATIC_REQUIRE(sizeof(UniqueSocket) == sizeof(SOCKET));
+	STATIC_REQUIRE(!std::is_copy_constructible_v<UniqueSocket>);
+	STATIC_REQUIRE(!std::is_copy_assignable_v<UniqueSocket>);
+	STATIC_REQUIRE(std::is_nothrow_move_constructible_v<UniqueSocket>);
+	STATIC_REQUIRE(std::is_nothrow_move_assignable_v<UniqueSocket>);
+
+	const UniqueSocket sock;
+	REQUIRE(sock.FileNo() == INVALID_SOCKET);
+}
+
+TEST_CASE("Testing UniqueSocket ownership", "[UniqueSocket]")
+{
+	{//Move Constructor
+		UniqueSocket sock(AddressFamily::IPv4, SocketType::STREAM);
+		const SOCKET fd = sock.FileNo();
+		REQUIRE(fd != INVALID_SOCKET);
+
+		const UniqueSocket moved(std::move(sock));
+		REQUIRE(sock.FileNo() == INVALID_SOCKET);
+		REQUIRE(moved.FileNo() == fd);
+	}
+
+	{//Move assignment closes the previous socket
+		UniqueSocket sock(AddressFamily::IPv4, SocketType::STREAM);
+		UniqueSocket other(AddressFamily::IPv4, SocketType::DGRAM);
+		const SOCKET fd = other.FileNo();
+
+		sock = std::move(other);
+		REQUIRE(other.FileNo() == INVALID_SOCKET);
+		REQUIRE(sock.FileNo() == fd);
+	}
+
+	{//Release gives up ownership
+		UniqueSocket sock(AddressFamily::IPv4, SocketType::STREAM);
+		const SOCKET fd = sock.Release();
+		REQUIRE(sock.FileNo() == INVALID_SOCKET);
+		REQUIRE(fd != INVALID_SOCKET);
+
+		const UniqueSocket adopted(fd);
+		REQUIRE(adopted.FileNo() == fd);
+	}
+
+	{//Shared ownership is an opt-in
+		UniqueSocket sock(AddressFamily::IPv4, SocketType::STREAM);
+		const SOCKET fd = sock.FileNo();
+
+		const Socket shared(std::move(sock), AddressFamily::IPv4);
+		const Socket copy(shared);
+		REQUIRE(sock.FileNo() == INVALID_SOCKET);
+		REQUIRE(shared.FileNo() == fd);
+		REQUIRE(copy.FileNo() == fd);
+	}
+}
+
+TEST_CASE("Testing UniqueSocket Stream Transmission", "[UniqueSocket]")
+{
+	const sockaddr_in address = LoopbackAddress(55695);
+	const UniqueSocket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+	server.Bind(reinterpret_cast<const sockaddr*>(&address), sizeof(sockaddr_in));
+	server.Listen();
+
+	auto task = std::async(std::launch::async, [&address]()
+	{
+		const UniqueSocket client(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		client.Connect(reinterpret_cast<const sockaddr*>(&address), sizeof(sockaddr_in));
+		REQUIRE(client.Send("Hello", 6) == 6);
+
+		char buffer[16] = { 0 };
+		REQUIRE(client.Receive(buffer, 16) == 6);
+		REQUIRE(std::string("World") == buffer);
+	});
+
+	sockaddr_in peer = { 0 };
+	socklen_t size = sizeof(sockaddr_in);
+	const UniqueSocket client = server.Accept(reinterpret_cast<sockaddr*>(&peer), &size);
+	REQUIRE(client.FileNo() != INVALID_SOCKET);
+	REQUIRE(size == sizeof(sockaddr_in));
+	REQUIRE(peer.sin_family == AF_INET);
+
+	char buffer[16] = { 0 };
+	REQUIRE(client.Receive(buffer, 16) == 6);
+	REQUIRE(std::string("Hello") == buffer);
+	REQUIRE(client.Send("World", 6) == 6);
+	task.wait();
+}
+
+TEST_CASE("Testing UniqueSocket Accept timeout", "[UniqueSocket]")
+{
+	const sockaddr_in address = LoopbackAddress(55715);
+	const UniqueSocket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+	server.Bind(reinterpret_cast<const sockaddr*>(&address), sizeof(sockaddr_in));
+	server.Listen();
+	server.SetBlocking(false);
+
+	const UniqueSocket client = server.Accept();
+	REQUIRE(client.FileNo() == INVALID_SOCKET);
+}
+
+TEST_CASE("Testing UniqueSocket AcceptMany", "[UniqueSocket]")
+{
+	SocketOptions options;
+	options.NonBlocking = true;
+	const sockaddr_in address = LoopbackAddress(56065);
+	const UniqueSocket server(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP, options);
+	server.Bind(reinterpret_cast<const sockaddr*>(&address), sizeof(sockaddr_in));
+	server.Listen();
+
+	Accepted connections[3];
+	const Result<size_t> none = server.AcceptMany(connections);
+	REQUIRE(!none);
+	REQUIRE(WouldBlock(none.error()));
+
+	std::vector<UniqueSocket> clients;
+	for (int i = 0; i < 5; i++)
+	{
+		clients.emplace_back(AddressFamily::IPv4, SocketType::STREAM, IPPROTO_TCP);
+		clients.back().Connect(reinterpret_cast<const sockaddr*>(&address), sizeof(sockaddr_in));
+	}
+
+	//The span limits a single call, the rest stays in the backlog
+	REQUIRE(server.AcceptMany(connections).value() == 3);
+	sockaddr_in local = { 0 };
+	socklen_t size = sizeof(local);
+	getsockname(clients.front().FileNo(), reinterpret_cast<sockaddr*>(&local), &size);
+	REQUIRE(connections[0].Peer == SocketAddress(reinterpret_cast<const sockaddr*>(&local), size));
+	for (const Accepted& connection : connections)
+	{
+		REQUIRE(connection.Sock.FileNo() != INVALID_SOCKET);
+		REQUIRE(connection.Peer.Host() == "127.0.0.1");
+	#ifndef PLATFORM_WINDOWS
+		REQUIRE((fcntl(connection.Sock.FileNo(), F_GETFL) & O_NONBLOCK) != 0);
+		REQUIRE((fcntl(connection.Sock.FileNo(), F_GETFD) & FD_CLOEXEC) != 0);
+	#endif
+	}
+
+	//Entries past the returned count are left as they were
+	const SOCKET last = connections[2].Sock.FileNo();
+	REQUIRE(server.AcceptMany(connections).value() == 2);
+	REQUIRE(connections[2].Sock.FileNo() == last);
+	REQUIRE(WouldBlock(server.AcceptMany(connections).error()));
+
+	//A socket that can't listen fails at once
+	const UniqueSocket udp(AddressFamily::IPv4, SocketType::DGRAM, IPPROTO_UDP, options);
+	const Result<size_t> failed = udp.AcceptMany(connections);
+	REQUIRE(!failed);
+	REQUIRE(!WouldBlock(failed.error()));
+
+	//The accepted sockets work as they are
+	REQUIRE(clients[4].Send("Hello", 6) == 6);
+	char buffer[16] = { 0 };
+	REQUIRE(connections[1].Sock.ReceiveExact(buffer, 6, 1000).has_value());
+	REQUIRE(std::string("Hello") == buffer);
+}
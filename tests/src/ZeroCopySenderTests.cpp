@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include <socklib/ZeroCopySender.h>
+
+#include <future>
+#include <vector>
+using namespace socklib;
+
+TEST_CASE("Testing ZeroCopySender", "[ZeroCopySender]")
+{
+	static constexpr size_t chunk = 256 * KiB;
+	static constexpr size_t chunks = 16;
+	const Socket server = Socket::CreateServer(AddressFamily::IPv4, { "127.0.0.1", 55845 });
+	const Socket client = Socket::CreateConnection(AddressFamily::IPv4, { "127.0.0.1", 55845 });
+	const Socket peer = server.Accept().first;
+
+	auto task = std::async(std::launch::async, [&peer]()
+	{
+		std::vector<BYTE> buffer(64 * KiB);
+		size_t received = 0;
+		IOSize bytes;
+		while ((bytes = peer.Receive(buffer.data(), buffer.size())) > 0)
+			received += bytes;
+		return received;
+	});
+
+	ZeroCopySender sender(client);
+#ifdef PLATFORM_LINUX
+	REQUIRE(sender.IsEnabled());
+#endif
+
+	const std::vector<BYTE> payload(chunk, 0xAB);
+	size_t released = 0, sent = 0;
+	for (size_t i = 0; i < chunks; i++)
+	{
+		size_t offset = 0;
+		while (offset < chunk)
+		{
+			const Result<size_t> bytes = sender.Send(payload.data() + offset, chunk - offset, [&released]() { released++; });
+			REQUIRE(bytes);
+			offset += *bytes;
+			sent++;
+		}
+	}
+
+	//Small sends are copied, so their buffer is released right away
+	const char message[] = "tail";
+	bool copied = false;
+	REQUIRE(sender.Send(message, sizeof(message), [&copied]() { copied = true; }).value_or(0) == sizeof(message));
+	REQUIRE(copied);
+
+	REQUIRE(sender.WaitForCompletions(5000));
+	REQUIRE(sender.Pending() == 0);
+	REQUIRE(released == sent);
+
+	const ZeroCopySender::Stats& stats = sender.GetStats();
+	REQUIRE(stats.Fallback + stats.ZeroCopy == sent + 1);
+	REQUIRE(stats.Copied <= stats.ZeroCopy);
+
+	client.Shutdown(SHUT_WR);
+	REQUIRE(task.get() == chunk * chunks + sizeof(message));
+}